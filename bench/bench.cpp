@@ -0,0 +1,382 @@
+/**
+ * @file bench.cpp
+ * @brief Microbenchmarks of the interpolators (fit & batch evaluation) and of the data input/output
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Benchmarks are named <operation>/<scheme>/<type>/<nodes>/<N>, e.g. "eval/Barycentric/double/CHEBYSHEV/1000".
+ * The read benchmarks are sized by file instead, e.g. "read/text/double/RANDOM/100MB".
+ * Usage: ./bench [--filter regex] [--min-time s] [--max-n N] [--max-file-mb MB] [--format json|csv] [--output file]
+ */
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include "boost/program_options.hpp"
+#include "benchmark.hpp"
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "data_reader.hpp"
+#include "datagen.hpp"
+#include "fixed_interpolators.hpp"
+#include "fourier_approximator.hpp"
+#include "lagrange_interpolator.hpp"
+#include "static_interpolator.hpp"
+
+/* Number of query points of the batch evaluations */
+#define BENCH_QUERIES 1000
+
+/* Largest N of every scheme (polynomial fit or evaluation cost grows faster than N, the spline fit is O(N)) */
+#define LAGRANGE_MAX_N 1000
+#define BARYCENTRIC_MAX_N 10000
+#define CUBIC_SPLINE_MAX_N 10000000
+#define FOURIER_MAX_N 10000000
+#define IO_MAX_N 10000000
+
+/* Largest text file (MB) of the read throughput benchmarks, which sweep 1 MB, 10 MB, 100 MB, ... */
+#define READ_MAX_FILE_MB 1000
+
+template <typename T> std::string type_name();
+template <> std::string type_name<float>() { return "float"; }
+template <> std::string type_name<double>() { return "double"; }
+template <> std::string type_name<long double>() { return "long_double"; }
+
+template <typename T>
+std::string node_name(typename datagen<T>::PointGeneration pg)
+{
+    switch (pg)
+    {
+        case datagen<T>::PointGeneration::CHEBYSHEV: return "CHEBYSHEV";
+        case datagen<T>::PointGeneration::UNIFORM: return "UNIFORM";
+        default: return "RANDOM";
+    }
+}
+
+/**
+ * @brief Sorted nodes on [-1, 1] and the damped cosine sampled on them
+ */
+template <typename T>
+void make_nodes(Eigen::Index n, typename datagen<T>::PointGeneration pg, Eigen::VectorX<T>& x, Eigen::VectorX<T>& y)
+{
+    x.resize(n);
+    datagen<T>::generate_points(x, {T(-1), T(1)}, pg);
+    std::sort(x.begin(), x.end());
+    Eigen::VectorX<T> params(3);
+    params << T(1), T(2), T(10);
+    datagen<T>::damped_cosine(y, x, params);
+}
+
+template <typename T>
+void register_interpolator(BenchmarkRunner& runner, const std::string& scheme, Eigen::Index max_n,
+                           const std::function<std::unique_ptr<Interpolator<T>>()>& make)
+{
+    const std::vector<typename datagen<T>::PointGeneration> node_sets = {
+        datagen<T>::PointGeneration::CHEBYSHEV, datagen<T>::PointGeneration::UNIFORM, datagen<T>::PointGeneration::RANDOM_UNIFORM};
+
+    for (Eigen::Index n = 10; n <= max_n; n *= 10)
+    {
+        for (auto pg : node_sets)
+        {
+            const std::string suffix = std::format("{}/{}/{}/{}", scheme, type_name<T>(), node_name<T>(pg), n);
+            runner.add("fit/" + suffix, [=](BenchmarkState& state) {
+                Eigen::VectorX<T> x, y;
+                make_nodes<T>(n, pg, x, y);
+                Eigen::MatrixX<T> data(n, 2);
+                data << x, y;
+                std::unique_ptr<Interpolator<T>> interpolator = make();
+                for ([[maybe_unused]] auto _ : state)
+                {
+                    interpolator->fit(data, 1);
+                    do_not_optimize(interpolator);
+                }
+                state.set_items_per_iteration(n);
+            });
+            runner.add("eval/" + suffix, [=](BenchmarkState& state) {
+                Eigen::VectorX<T> x, y;
+                make_nodes<T>(n, pg, x, y);
+                Eigen::MatrixX<T> data(n, 2);
+                data << x, y;
+                std::unique_ptr<Interpolator<T>> interpolator = make();
+                interpolator->fit(data, 1);
+                Eigen::MatrixX<T> queries = Eigen::VectorX<T>::LinSpaced(BENCH_QUERIES, x.minCoeff(), x.maxCoeff());
+                for ([[maybe_unused]] auto _ : state)
+                {
+                    Eigen::VectorX<T> values = (*interpolator)(queries);
+                    do_not_optimize(values.data());
+                }
+                state.set_items_per_iteration(BENCH_QUERIES);
+            });
+        }
+    }
+}
+
+template <typename T>
+void register_fourier(BenchmarkRunner& runner, Eigen::Index max_n)
+{
+    for (Eigen::Index n = 10; n <= max_n; n *= 10)
+    {
+        const std::string suffix = std::format("Fourier/{}/UNIFORM/{}", type_name<T>(), n);
+        runner.add("fit/" + suffix, [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(n, datagen<T>::PointGeneration::UNIFORM, x, y);
+            FourierApproximator<T> approximator;
+            for ([[maybe_unused]] auto _ : state)
+            {
+                approximator.fit(y);
+                do_not_optimize(approximator);
+            }
+            state.set_items_per_iteration(n);
+        });
+        runner.add("eval/" + suffix, [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(n, datagen<T>::PointGeneration::UNIFORM, x, y);
+            FourierApproximator<T> approximator;
+            approximator.fit(y);
+            for ([[maybe_unused]] auto _ : state)
+            {
+                Eigen::VectorX<T> values = approximator.approximate_points(n);
+                do_not_optimize(values.data());
+            }
+            state.set_items_per_iteration(n);
+        });
+        // Arbitrary points (non-uniform FFT)
+        runner.add("query/" + suffix, [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(n, datagen<T>::PointGeneration::UNIFORM, x, y);
+            FourierApproximator<T> approximator;
+            approximator.fit(y);
+            Eigen::MatrixX<T> queries = (Eigen::VectorX<T>::Random(BENCH_QUERIES).array() + T(1)) * T(n / 2);
+            for ([[maybe_unused]] auto _ : state)
+            {
+                Eigen::VectorX<T> values = approximator(queries);
+                do_not_optimize(values.data());
+            }
+            state.set_items_per_iteration(BENCH_QUERIES);
+        });
+        // Streaming (sliding DFT over the N bins)
+        runner.add("push/" + suffix, [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(n, datagen<T>::PointGeneration::UNIFORM, x, y);
+            FourierApproximator<T> approximator;
+            approximator.fit(y);
+            Eigen::VectorX<T> samples = Eigen::VectorX<T>::Random(BENCH_QUERIES);
+            for ([[maybe_unused]] auto _ : state)
+            {
+                approximator.push(samples);
+                do_not_optimize(approximator);
+            }
+            state.set_items_per_iteration(BENCH_QUERIES);
+        });
+    }
+}
+
+/**
+ * @brief Point by point queries of small models: fixed-size interpolators, dynamic ones called through
+ * the Interpolator<T> interface ("query", a virtual call per point) or through StaticInterpolator<T>
+ * ("visit", direct calls per point & "batch", a single dispatch per batch)
+ */
+template <typename T, int N>
+void register_small_models(BenchmarkRunner& runner)
+{
+    const std::string suffix = std::format("{}/UNIFORM/{}", type_name<T>(), N);
+    auto fixed = [&runner, suffix]<typename Fixed>(const std::string& scheme) {
+        runner.add(std::format("query/{}/{}", scheme, suffix), [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(N, datagen<T>::PointGeneration::UNIFORM, x, y);
+            Fixed interpolator;
+            interpolator.fit(x, y);
+            Eigen::VectorX<T> queries = Eigen::VectorX<T>::LinSpaced(BENCH_QUERIES, x.minCoeff(), x.maxCoeff());
+            for ([[maybe_unused]] auto _ : state)
+            {
+                T sum = 0;
+                for (Eigen::Index i = 0; i < queries.rows(); i++) { sum += interpolator(queries(i)); }
+                do_not_optimize(sum);
+            }
+            state.set_items_per_iteration(BENCH_QUERIES);
+        });
+    };
+    auto dynamic = [&runner, suffix](const std::string& scheme, std::function<std::unique_ptr<Interpolator<T>>()> make) {
+        runner.add(std::format("query/{}/{}", scheme, suffix), [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(N, datagen<T>::PointGeneration::UNIFORM, x, y);
+            Eigen::MatrixX<T> data(N, 2);
+            data << x, y;
+            std::unique_ptr<Interpolator<T>> interpolator = make();
+            interpolator->fit(data, 1);
+            Eigen::VectorX<T> queries = Eigen::VectorX<T>::LinSpaced(BENCH_QUERIES, x.minCoeff(), x.maxCoeff());
+            for ([[maybe_unused]] auto _ : state)
+            {
+                T sum = 0;
+                for (Eigen::Index i = 0; i < queries.rows(); i++) { sum += (*interpolator)(queries(i)); }
+                do_not_optimize(sum);
+            }
+            state.set_items_per_iteration(BENCH_QUERIES);
+        });
+        runner.add(std::format("visit/{}/{}", scheme, suffix), [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(N, datagen<T>::PointGeneration::UNIFORM, x, y);
+            Eigen::MatrixX<T> data(N, 2);
+            data << x, y;
+            std::unique_ptr<Interpolator<T>> interpolator = make();
+            interpolator->fit(data, 1);
+            const StaticInterpolator<T> dispatch(*interpolator);
+            Eigen::VectorX<T> queries = Eigen::VectorX<T>::LinSpaced(BENCH_QUERIES, x.minCoeff(), x.maxCoeff());
+            for ([[maybe_unused]] auto _ : state)
+            {
+                T sum = dispatch.visit([&](auto& concrete) {
+                    T partial = 0;
+                    for (Eigen::Index i = 0; i < queries.rows(); i++) { partial += concrete(queries(i)); }
+                    return partial;
+                });
+                do_not_optimize(sum);
+            }
+            state.set_items_per_iteration(BENCH_QUERIES);
+        });
+        runner.add(std::format("batch/{}/{}", scheme, suffix), [=](BenchmarkState& state) {
+            Eigen::VectorX<T> x, y;
+            make_nodes<T>(N, datagen<T>::PointGeneration::UNIFORM, x, y);
+            Eigen::MatrixX<T> data(N, 2);
+            data << x, y;
+            std::unique_ptr<Interpolator<T>> interpolator = make();
+            interpolator->fit(data, 1);
+            const StaticInterpolator<T> dispatch(*interpolator);
+            Eigen::MatrixX<T> queries = Eigen::VectorX<T>::LinSpaced(BENCH_QUERIES, x.minCoeff(), x.maxCoeff());
+            for ([[maybe_unused]] auto _ : state)
+            {
+                Eigen::VectorX<T> values = dispatch(queries);
+                do_not_optimize(values.data());
+            }
+            state.set_items_per_iteration(BENCH_QUERIES);
+        });
+    };
+    fixed.template operator()<FixedBarycentricInterpolator<T, N>>("FixedBarycentric");
+    fixed.template operator()<FixedLagrangeInterpolator<T, N>>("FixedLagrange");
+    dynamic("Barycentric", [] { return std::make_unique<BarycentricInterpolator<T>>(); });
+    dynamic("Lagrange", [] { return std::make_unique<LagrangeInterpolator<T>>(); });
+    dynamic("CubicSpline", [] { return std::make_unique<CubicSplineInterpolator<T>>(); });
+}
+
+template <typename T>
+void register_io(BenchmarkRunner& runner, Eigen::Index max_n, Eigen::Index max_file_mb, const std::filesystem::path& folder)
+{
+    // Read throughput by file size, the row count giving each size is measured on a small file
+    for (Eigen::Index mb = 1; mb <= max_file_mb; mb *= 10)
+    {
+        const std::filesystem::path path = folder / std::format("bench_read_{}_{}MB.txt", type_name<T>(), mb);
+        runner.add(std::format("read/text/{}/RANDOM/{}MB", type_name<T>(), mb), [=](BenchmarkState& state) {
+            const Eigen::Index probe_rows = 10000;
+            datagen<T>::random_data(path, probe_rows, 2);
+            const double bytes_per_row = double(std::filesystem::file_size(path)) / probe_rows;
+            const Eigen::Index n = std::max<Eigen::Index>(1, Eigen::Index(mb * 1e6 / bytes_per_row));
+            datagen<T>::random_data(path, n, 2);
+            for ([[maybe_unused]] auto _ : state)
+            {
+                Eigen::MatrixX<T> data = DataReader<T>::read(path);
+                do_not_optimize(data.data());
+            }
+            state.set_items_per_iteration(n);
+            state.set_bytes_per_iteration(std::filesystem::file_size(path));
+            std::filesystem::remove(path);
+        });
+    }
+
+    for (Eigen::Index n = 10; n <= max_n; n *= 10)
+    {
+        const std::filesystem::path path = folder / std::format("bench_io_{}_{}.txt", type_name<T>(), n);
+        runner.add(std::format("write/text/{}/RANDOM/{}", type_name<T>(), n), [=](BenchmarkState& state) {
+            Eigen::MatrixX<T> data(n, 2);
+            RandomGenerator<T>().fill(data, T(-1), T(1));
+            for ([[maybe_unused]] auto _ : state)
+            {
+                datagen<T>::write(path, data);
+            }
+            state.set_items_per_iteration(n);
+            state.set_bytes_per_iteration(std::filesystem::file_size(path));
+            std::filesystem::remove(path);
+        });
+    }
+}
+
+template <typename T>
+void register_all(BenchmarkRunner& runner, Eigen::Index max_n, Eigen::Index max_file_mb, const std::filesystem::path& folder)
+{
+    register_interpolator<T>(runner, "Lagrange", std::min<Eigen::Index>(max_n, LAGRANGE_MAX_N),
+                             [] { return std::make_unique<LagrangeInterpolator<T>>(); });
+    register_interpolator<T>(runner, "Barycentric", std::min<Eigen::Index>(max_n, BARYCENTRIC_MAX_N),
+                             [] { return std::make_unique<BarycentricInterpolator<T>>(); });
+    register_interpolator<T>(runner, "CubicSpline", std::min<Eigen::Index>(max_n, CUBIC_SPLINE_MAX_N),
+                             [] { return std::make_unique<CubicSplineInterpolator<T>>(); });
+    register_interpolator<T>(runner, "BarycentricCompensated", std::min<Eigen::Index>(max_n, BARYCENTRIC_MAX_N), [] {
+        auto interpolator = std::make_unique<BarycentricInterpolator<T>>();
+        interpolator->set_summation_mode(SummationMode::COMPENSATED);
+        return interpolator;
+    });
+    register_interpolator<T>(runner, "CubicSplineCompensated", std::min<Eigen::Index>(max_n, CUBIC_SPLINE_MAX_N), [] {
+        auto interpolator = std::make_unique<CubicSplineInterpolator<T>>();
+        interpolator->set_summation_mode(SummationMode::COMPENSATED);
+        return interpolator;
+    });
+    if constexpr (std::is_same_v<T, double>)
+    {
+        // Float storage, double evaluation
+        register_interpolator<T>(runner, "BarycentricFloatStorage", std::min<Eigen::Index>(max_n, BARYCENTRIC_MAX_N),
+                                 [] { return std::make_unique<BarycentricInterpolator<double, float>>(); });
+        register_interpolator<T>(runner, "CubicSplineFloatStorage", std::min<Eigen::Index>(max_n, CUBIC_SPLINE_MAX_N),
+                                 [] { return std::make_unique<CubicSplineInterpolator<double, float>>(); });
+    }
+    register_fourier<T>(runner, std::min<Eigen::Index>(max_n, FOURIER_MAX_N));
+    register_small_models<T, 4>(runner);
+    register_small_models<T, 8>(runner);
+    register_small_models<T, 16>(runner);
+    register_io<T>(runner, std::min<Eigen::Index>(max_n, IO_MAX_N), max_file_mb, folder);
+}
+
+int main(int argc, char **argv)
+{
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("filter", po::value<std::string>()->default_value("."), "only run the benchmarks whose name matches this regular expression")
+        ("min-time", po::value<double>()->default_value(DEFAULT_BENCHMARK_MIN_TIME), "minimum measured time of every benchmark (s)")
+        ("max-n", po::value<Eigen::Index>()->default_value(10000000), "largest number of datapoints")
+        ("max-file-mb", po::value<Eigen::Index>()->default_value(READ_MAX_FILE_MB), "largest file read by the read benchmarks (MB)")
+        ("format", po::value<std::string>()->default_value("json"), "report format: json or csv")
+        ("output,o", po::value<std::string>(), "report file (default: standard output)")
+        ("folder", po::value<std::string>()->default_value(std::filesystem::temp_directory_path().string()), "folder of the temporary data files");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    const std::string format = vm["format"].as<std::string>();
+    if (format != "json" && format != "csv")
+    {
+        std::cerr << "Unknown report format: " << format << std::endl;
+        return 1;
+    }
+
+    const Eigen::Index max_n = vm["max-n"].as<Eigen::Index>();
+    const Eigen::Index max_file_mb = vm["max-file-mb"].as<Eigen::Index>();
+    const std::filesystem::path folder = vm["folder"].as<std::string>();
+    BenchmarkRunner runner;
+    register_all<float>(runner, max_n, max_file_mb, folder);
+    register_all<double>(runner, max_n, max_file_mb, folder);
+    register_all<long double>(runner, max_n, max_file_mb, folder);
+
+    // Progress goes to stderr so the report can be redirected
+    std::vector<BenchmarkResult> results = runner.run(vm["filter"].as<std::string>(), vm["min-time"].as<double>(), &std::cerr);
+
+    std::ofstream file;
+    if (vm.count("output")) { file.open(vm["output"].as<std::string>()); }
+    std::ostream& out = vm.count("output") ? file : std::cout;
+    if (format == "json") { BenchmarkRunner::write_json(out, results); }
+    else { BenchmarkRunner::write_csv(out, results); }
+    return 0;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file benchmark.hpp
+ * @brief Minimal Google-Benchmark-style harness: registered benchmarks, adaptive iteration
+ * counts and JSON/CSV reports
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Minimum measured time of every benchmark (s) */
+#define DEFAULT_BENCHMARK_MIN_TIME 0.5
+
+/* Maximum number of iterations of a benchmark */
+#define MAX_BENCHMARK_ITERATIONS 1000000000
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of value
+ */
+template <typename V>
+inline void do_not_optimize(V const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief State of a running benchmark. The timed region is the range-for loop over the state:
+ *
+ *     for ([[maybe_unused]] auto _ : state) { ... }
+ *
+ * the setup before the loop is not measured.
+ */
+class BenchmarkState {
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::int64_t _iterations;
+        Clock::time_point _start;
+        std::clock_t _cpu_start = 0;
+        bool _running = false;
+        double _real_time = 0;
+        double _cpu_time = 0;
+        std::int64_t _items = 0;
+        std::int64_t _bytes = 0;
+        std::string _skip_message;
+
+    public:
+        struct Iterator {
+            BenchmarkState* state;
+            std::int64_t remaining;
+
+            bool operator!=(const Iterator&)
+            {
+                if (this->remaining > 0) { return true; }
+                this->state->pause_timing();
+                return false;
+            }
+            void operator++() { this->remaining--; }
+            int operator*() const { return 0; }
+        };
+
+        explicit BenchmarkState(std::int64_t iterations) : _iterations(iterations) {}
+
+        Iterator begin()
+        {
+            this->resume_timing();
+            return Iterator{this, this->_iterations};
+        }
+        Iterator end() { return Iterator{this, 0}; }
+
+        /**
+         * @brief Stops the timer (e.g. around a per-iteration setup)
+         */
+        void pause_timing()
+        {
+            if (!this->_running) { return; }
+            this->_real_time += std::chrono::duration<double>(Clock::now() - this->_start).count();
+            this->_cpu_time += double(std::clock() - this->_cpu_start) / CLOCKS_PER_SEC;
+            this->_running = false;
+        }
+
+        /**
+         * @brief Restarts the timer
+         */
+        void resume_timing()
+        {
+            if (this->_running) { return; }
+            this->_running = true;
+            this->_cpu_start = std::clock();
+            this->_start = Clock::now();
+        }
+
+        /**
+         * @brief Reports the benchmark as skipped (e.g. unsupported size), the loop must not be entered
+         */
+        void skip(const std::string& message) { this->_skip_message = message; }
+
+        /**
+         * @brief Number of items (e.g. queries, datapoints) processed by every iteration
+         */
+        void set_items_per_iteration(std::int64_t items) { this->_items = items; }
+
+        /**
+         * @brief Number of bytes processed by every iteration
+         */
+        void set_bytes_per_iteration(std::int64_t bytes) { this->_bytes = bytes; }
+
+        std::int64_t iterations() const { return this->_iterations; }
+        double real_time() const { return this->_real_time; }
+        double cpu_time() const { return this->_cpu_time; }
+        std::int64_t items() const { return this->_items; }
+        std::int64_t bytes() const { return this->_bytes; }
+        const std::string& skip_message() const { return this->_skip_message; }
+};
+
+/**
+ * @brief Measurement of one benchmark
+ */
+struct BenchmarkResult {
+    std::string name;
+    std::int64_t iterations = 0;
+    /* Time per iteration (ns) */
+    double real_time_ns = 0;
+    double cpu_time_ns = 0;
+    double items_per_second = 0;
+    double bytes_per_second = 0;
+    /* Non empty if the benchmark was skipped */
+    std::string skip_message;
+};
+
+/**
+ * @brief Registry & runner of the benchmarks
+ */
+class BenchmarkRunner {
+
+    private:
+        struct Benchmark {
+            std::string name;
+            std::function<void(BenchmarkState&)> function;
+        };
+
+        std::vector<Benchmark> _benchmarks;
+
+    public:
+        /**
+         * @brief Registers a benchmark, names are '/' separated paths (e.g. "fit/Barycentric/double/CHEBYSHEV/1000")
+         */
+        void add(const std::string& name, std::function<void(BenchmarkState&)> function)
+        {
+            this->_benchmarks.push_back({name, std::move(function)});
+        }
+
+        /**
+         * @brief Runs the benchmarks whose name matches filter. The number of iterations grows
+         * until the timed loop lasts at least min_time seconds.
+         *
+         * @param filter regular expression searched in the names
+         * @param min_time minimum measured time (s)
+         * @param progress stream receiving one line per finished benchmark (nullptr for none)
+         * @return std::vector<BenchmarkResult> the measurements
+         */
+        std::vector<BenchmarkResult> run(const std::string& filter, double min_time, std::ostream* progress = nullptr) const
+        {
+            const std::regex pattern(filter);
+            std::vector<BenchmarkResult> results;
+            for (const Benchmark& benchmark : this->_benchmarks)
+            {
+                if (!std::regex_search(benchmark.name, pattern)) { continue; }
+
+                BenchmarkResult result;
+                result.name = benchmark.name;
+                std::int64_t iterations = 1;
+                while (true)
+                {
+                    BenchmarkState state(iterations);
+                    benchmark.function(state);
+                    if (!state.skip_message().empty())
+                    {
+                        result.skip_message = state.skip_message();
+                        break;
+                    }
+                    if (state.real_time() >= min_time || iterations >= MAX_BENCHMARK_ITERATIONS)
+                    {
+                        result.iterations = iterations;
+                        result.real_time_ns = state.real_time() * 1e9 / iterations;
+                        result.cpu_time_ns = state.cpu_time() * 1e9 / iterations;
+                        result.items_per_second = state.items() * iterations / state.real_time();
+                        result.bytes_per_second = state.bytes() * iterations / state.real_time();
+                        break;
+                    }
+                    // Aim slightly above min_time, growing at most 10x per run
+                    const double ratio = state.real_time() > 0 ? 1.4 * min_time / state.real_time() : 10.0;
+                    iterations = std::min<std::int64_t>(MAX_BENCHMARK_ITERATIONS, std::max<std::int64_t>(iterations + 1, iterations * std::min(ratio, 10.0)));
+                }
+
+                if (progress)
+                {
+                    if (result.skip_message.empty())
+                    {
+                        *progress << std::format("{:<56} {:>14.0f} ns {:>12} it", result.name, result.real_time_ns, result.iterations) << std::endl;
+                    }
+                    else
+                    {
+                        *progress << std::format("{:<56} skipped: {}", result.name, result.skip_message) << std::endl;
+                    }
+                }
+                results.push_back(result);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Writes the results as CSV (one line per benchmark)
+         */
+        static void write_csv(std::ostream& out, const std::vector<BenchmarkResult>& results)
+        {
+            out << "name,iterations,real_time_ns,cpu_time_ns,items_per_second,bytes_per_second,skipped\n";
+            for (const BenchmarkResult& result : results)
+            {
+                out << std::format("{},{},{:.3f},{:.3f},{:.6g},{:.6g},{}\n", result.name, result.iterations, result.real_time_ns,
+                                   result.cpu_time_ns, result.items_per_second, result.bytes_per_second, result.skip_message);
+            }
+        }
+
+        /**
+         * @brief Writes the results as JSON, following the layout of Google Benchmark reports
+         */
+        static void write_json(std::ostream& out, const std::vector<BenchmarkResult>& results)
+        {
+            const auto escape = [](const std::string& s) {
+                std::string escaped;
+                for (char c : s)
+                {
+                    if (c == '"' || c == '\\') { escaped += '\\'; }
+                    escaped += c;
+                }
+                return escaped;
+            };
+
+            out << "{\n  \"context\": {\n";
+            out << std::format("    \"date\": \"{:%FT%TZ}\",\n", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+            out << std::format("    \"num_cpus\": {}\n", std::thread::hardware_concurrency());
+            out << "  },\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results.size(); i++)
+            {
+                const BenchmarkResult& result = results[i];
+                out << "    {\n";
+                out << std::format("      \"name\": \"{}\",\n", escape(result.name));
+                if (!result.skip_message.empty())
+                {
+                    out << std::format("      \"skipped\": \"{}\"\n", escape(result.skip_message));
+                }
+                else
+                {
+                    out << std::format("      \"iterations\": {},\n", result.iterations);
+                    out << std::format("      \"real_time\": {:.3f},\n", result.real_time_ns);
+                    out << std::format("      \"cpu_time\": {:.3f},\n", result.cpu_time_ns);
+                    out << "      \"time_unit\": \"ns\",\n";
+                    out << std::format("      \"items_per_second\": {:.6g},\n", result.items_per_second);
+                    out << std::format("      \"bytes_per_second\": {:.6g}\n", result.bytes_per_second);
+                }
+                out << (i + 1 < results.size() ? "    },\n" : "    }\n");
+            }
+            out << "  ]\n}\n";
+        }
+};
@@ -0,0 +1,288 @@
+/**
+ * @file convergence.cpp
+ * @brief Accuracy versus cost sweep of the interpolators on analytic functions generated by datagen
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * For every function, sampling and scheme, the node count is doubled up to the scheme's cap and the fit time,
+ * the per-query latency, the peak memory and the max/RMS error against the analytic function are recorded.
+ * Writes a table (Pareto optimal runs marked with '*') to the standard output, convergence.csv and one gnuplot
+ * script per function & sampling (error versus cost) into the output folder.
+ *
+ * Usage: ./convergence [--output folder] [--queries Q] [--max-n N] [--min-time s]
+ */
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include "boost/program_options.hpp"
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "data_writer.hpp"
+#include "datagen.hpp"
+#include "lagrange_interpolator.hpp"
+#include "plotter.hpp"
+
+/* Node count caps (polynomial fit or evaluation cost grows faster than N, the spline fit is O(N)) */
+#define LAGRANGE_MAX_N 512
+#define BARYCENTRIC_MAX_N 4096
+#define CUBIC_SPLINE_MAX_N 1048576
+
+/**
+ * @brief Analytic function sampled by the sweep
+ */
+struct Problem {
+    std::string name;
+    std::pair<double, double> range;
+    std::function<void(Eigen::VectorXd& y, Eigen::VectorXd& x)> evaluate;
+
+    /* Central difference derivative, for the clamped spline boundary */
+    double derivative(double x) const
+    {
+        const double h = 1e-6;
+        Eigen::VectorXd points(2), values(2);
+        points << x - h, x + h;
+        this->evaluate(values, points);
+        return (values(1) - values(0)) / (2 * h);
+    }
+};
+
+/**
+ * @brief Interpolation scheme, made for the given problem & first/last nodes
+ */
+struct Scheme {
+    std::string name;
+    Eigen::Index max_n;
+    std::function<std::unique_ptr<Interpolator<double>>(const Problem&, double, double)> make;
+};
+
+struct Measurement {
+    std::string function;
+    std::string sampling;
+    std::string scheme;
+    Eigen::Index n;
+    double fit_time;
+    double query_latency;
+    long peak_memory_kb;
+    double max_error;
+    double rms_error;
+    /* Time to fit & evaluate the query batch */
+    double cost;
+    bool pareto = false;
+};
+
+/**
+ * @brief Reads a field (in kB) of /proc/self/status, -1 if unavailable
+ */
+long read_status_kb(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind(field + ":", 0) == 0) { return std::stol(line.substr(field.size() + 1)); }
+    }
+    return -1;
+}
+
+/**
+ * @brief Resets the peak resident set size (Linux) and returns the current resident set size
+ */
+long reset_peak_memory()
+{
+    std::ofstream("/proc/self/clear_refs") << "5";
+    return read_status_kb("VmRSS");
+}
+
+/**
+ * @brief Average duration of f (s), repeated until min_time is spent
+ */
+double time_per_call(const std::function<void()>& f, double min_time)
+{
+    int calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0);
+    do
+    {
+        f();
+        calls++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < min_time);
+    return elapsed.count() / calls;
+}
+
+Measurement measure(const Problem& problem, typename datagen<double>::PointGeneration pg, const Scheme& scheme,
+                    Eigen::Index n, const Eigen::VectorXd& queries, const Eigen::VectorXd& exact, double min_time)
+{
+    Eigen::VectorXd x(n), y(n);
+    datagen<double>::generate_points(x, problem.range, pg);
+    std::sort(x.begin(), x.end());
+    problem.evaluate(y, x);
+    Eigen::MatrixXd data(n, 2);
+    data << x, y;
+
+    const long baseline = reset_peak_memory();
+    std::unique_ptr<Interpolator<double>> interpolator = scheme.make(problem, x(0), x(n - 1));
+    // Chebyshev nodes do not reach the bounds: every scheme is judged on the whole range
+    interpolator->set_extrapolation_policy(ExtrapolationPolicy::EXTRAPOLATE);
+    const double fit_time = time_per_call([&] { interpolator->fit(data, 1); }, min_time);
+
+    Eigen::VectorXd values;
+    const double eval_time = time_per_call([&] { values = (*interpolator)(queries); }, min_time);
+    const long peak = read_status_kb("VmHWM");
+
+    Measurement m;
+    m.n = n;
+    m.scheme = scheme.name;
+    m.fit_time = fit_time;
+    m.query_latency = eval_time / queries.rows();
+    m.peak_memory_kb = (baseline < 0 || peak < 0) ? -1 : std::max(0L, peak - baseline);
+    m.max_error = (values - exact).cwiseAbs().maxCoeff();
+    m.rms_error = std::sqrt((values - exact).squaredNorm() / queries.rows());
+    m.cost = fit_time + eval_time;
+    return m;
+}
+
+/**
+ * @brief Marks the runs for which no other run is both cheaper and more accurate
+ */
+void mark_pareto(std::vector<Measurement>& group)
+{
+    std::sort(group.begin(), group.end(), [](const Measurement& a, const Measurement& b) {
+        return a.cost < b.cost || (a.cost == b.cost && a.max_error < b.max_error);
+    });
+    double best_error = std::numeric_limits<double>::infinity();
+    for (Measurement& m : group)
+    {
+        // NaN errors (diverged schemes) are never optimal
+        if (m.max_error < best_error)
+        {
+            m.pareto = true;
+            best_error = m.max_error;
+        }
+    }
+}
+
+/**
+ * @brief Writes the error versus cost data of every scheme and the gnuplot script plotting them
+ */
+void write_plot(const std::vector<Measurement>& group, const std::vector<Scheme>& schemes, const std::filesystem::path& folder)
+{
+    const std::string prefix = std::format("convergence_{}_{}", group.front().function, group.front().sampling);
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::string> titles, styles;
+    for (const Scheme& scheme : schemes)
+    {
+        std::vector<Measurement> runs;
+        std::copy_if(group.begin(), group.end(), std::back_inserter(runs), [&](const Measurement& m) { return m.scheme == scheme.name; });
+        if (runs.empty()) { continue; }
+        std::sort(runs.begin(), runs.end(), [](const Measurement& a, const Measurement& b) { return a.n < b.n; });
+        Eigen::MatrixXd data(runs.size(), 3);
+        for (std::size_t i = 0; i < runs.size(); i++)
+        {
+            data.row(i) << runs[i].cost, runs[i].max_error, double(runs[i].n);
+        }
+        paths.push_back(folder / std::format("{}_{}.txt", prefix, scheme.name));
+        DataWriter<double>::write(paths.back(), data);
+        titles.push_back(scheme.name);
+        styles.push_back("linespoints");
+    }
+
+    Plotter<double> plotter("cat > " + (folder / (prefix + ".gp")).string());
+    plotter << "set terminal pngcairo size 900,600 noenhanced\n";
+    plotter << std::format("set output '{}'\n", (folder / (prefix + ".png")).string());
+    plotter << std::format("set title '{} ({} nodes): max error versus fit + evaluation time'\n", group.front().function, group.front().sampling);
+    plotter << "set logscale xy\nset format y '%.0e'\nset xlabel 'time (s)'\nset ylabel 'max error'\nset key outside\n";
+    plotter.plot(paths.size(), paths.data(), titles.data(), styles.data());
+}
+
+int main(int argc, char **argv)
+{
+    namespace po = boost::program_options;
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("output,o", po::value<std::string>()->default_value("./output/"), "folder of the csv, data & gnuplot files")
+        ("queries", po::value<Eigen::Index>()->default_value(10000), "number of query points where the error is measured")
+        ("max-n", po::value<Eigen::Index>()->default_value(CUBIC_SPLINE_MAX_N), "largest node count")
+        ("min-time", po::value<double>()->default_value(0.02), "minimum measured time of every fit/evaluation (s)");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    const std::filesystem::path folder = vm["output"].as<std::string>();
+    const Eigen::Index n_queries = vm["queries"].as<Eigen::Index>();
+    const Eigen::Index max_n = vm["max-n"].as<Eigen::Index>();
+    const double min_time = vm["min-time"].as<double>();
+    std::filesystem::create_directories(folder);
+
+    Eigen::VectorXd poly_coeffs(6);
+    poly_coeffs << 1.0, -0.5, 0.25, 2.0, -1.0, 0.3;
+    Eigen::VectorXd cosine_params(3);
+    cosine_params << 1.0, 0.05, 2.0;
+    const std::vector<Problem> problems = {
+        {"polynomial", {-2.0, 2.0}, [poly_coeffs](Eigen::VectorXd& y, Eigen::VectorXd& x) mutable { datagen<double>::polynomial(y, x, poly_coeffs); }},
+        {"damped_cosine", {-10.0, 10.0}, [cosine_params](Eigen::VectorXd& y, Eigen::VectorXd& x) { datagen<double>::damped_cosine(y, x, cosine_params); }},
+    };
+    const std::vector<std::pair<std::string, typename datagen<double>::PointGeneration>> samplings = {
+        {"chebyshev", datagen<double>::PointGeneration::CHEBYSHEV},
+        {"uniform", datagen<double>::PointGeneration::UNIFORM},
+    };
+    const std::vector<Scheme> schemes = {
+        {"lagrange", LAGRANGE_MAX_N, [](const Problem&, double, double) { return std::make_unique<LagrangeInterpolator<double>>(); }},
+        {"barycentric", BARYCENTRIC_MAX_N, [](const Problem&, double, double) { return std::make_unique<BarycentricInterpolator<double>>(); }},
+        {"natural_spline", CUBIC_SPLINE_MAX_N, [](const Problem&, double, double) { return std::make_unique<CubicSplineInterpolator<double>>(); }},
+        {"clamped_spline", CUBIC_SPLINE_MAX_N, [](const Problem& problem, double first, double last) {
+            Eigen::Vector2d slopes(problem.derivative(first), problem.derivative(last));
+            return std::make_unique<CubicSplineInterpolator<double>>(CubicSplineInterpolator<double>::BoundaryConstraint::CLAMPED, slopes);
+        }},
+    };
+
+    std::ofstream csv(folder / "convergence.csv");
+    csv << "function,sampling,scheme,n,fit_time_s,query_latency_s,peak_memory_kb,max_error,rms_error,cost_s,pareto\n";
+    std::cout << std::format("{:<14} {:<10} {:<15} {:>6} {:>12} {:>12} {:>10} {:>11} {:>11}  {}\n",
+                             "function", "sampling", "scheme", "n", "fit (us)", "query (ns)", "peak (kB)", "max error", "rms error", "pareto");
+
+    for (const Problem& problem : problems)
+    {
+        Eigen::VectorXd queries = Eigen::VectorXd::LinSpaced(n_queries, problem.range.first, problem.range.second);
+        Eigen::VectorXd exact(n_queries);
+        problem.evaluate(exact, queries);
+
+        for (const auto& [sampling, pg] : samplings)
+        {
+            std::vector<Measurement> group;
+            for (const Scheme& scheme : schemes)
+            {
+                for (Eigen::Index n = 4; n <= std::min(scheme.max_n, max_n); n *= 2)
+                {
+                    Measurement m = measure(problem, pg, scheme, n, queries, exact, min_time);
+                    m.function = problem.name;
+                    m.sampling = sampling;
+                    group.push_back(m);
+                }
+            }
+            mark_pareto(group);
+
+            for (const Measurement& m : group)
+            {
+                std::cout << std::format("{:<14} {:<10} {:<15} {:>6} {:>12.2f} {:>12.2f} {:>10} {:>11.3e} {:>11.3e}  {}\n",
+                                         m.function, m.sampling, m.scheme, m.n, m.fit_time * 1e6, m.query_latency * 1e9,
+                                         m.peak_memory_kb, m.max_error, m.rms_error, m.pareto ? "*" : "");
+                csv << std::format("{},{},{},{},{:.6e},{:.6e},{},{:.6e},{:.6e},{:.6e},{}\n", m.function, m.sampling, m.scheme, m.n,
+                                   m.fit_time, m.query_latency, m.peak_memory_kb, m.max_error, m.rms_error, m.cost, int(m.pareto));
+            }
+            write_plot(group, schemes, folder);
+        }
+    }
+    return 0;
+}
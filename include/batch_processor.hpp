@@ -0,0 +1,112 @@
+/**
+ * @file batch_processor.hpp
+ * @brief Fits & evaluates interpolators on every data file of a directory in parallel
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/* Number of failed files whose error message is kept in the summary */
+#define BATCH_REPORTED_ERRORS 10
+
+/**
+ * @brief Aggregate counters of a batch run
+ *
+ */
+struct BatchSummary {
+    std::size_t files = 0;              ///< Discovered data files
+    std::size_t failed = 0;             ///< Files that could not be read, fitted or written
+    std::uint64_t datapoints = 0;       ///< Datapoints read (successful files only)
+    std::uint64_t bytes_read = 0;       ///< Size of the successful files on disk
+    std::uint64_t evaluations = 0;      ///< Interpolator evaluations written
+    double seconds = 0.0;               ///< Wall time of the run
+    std::vector<std::string> errors;    ///< "file: message" of the first BATCH_REPORTED_ERRORS failures
+
+    /**
+     * @brief Formats the counters & throughputs (files/s, MiB/s, evaluations/s)
+     */
+    std::string to_string() const;
+};
+
+/**
+ * @brief Runs the fit -> evaluate -> write pipeline of the CLI on every data file of a directory.
+ *
+ * Each file is a task of a WorkStealingPool: the files are dealt to the workers largest first,
+ * and idle workers steal the remaining ones, so a few large series do not hold back the run.
+ * A worker holds a single dataset (and its evaluated grid) at a time, the memory of a run thus
+ * stays bounded by workers x largest file whatever the number of files, and the reads & writes
+ * of some workers overlap the fits of the others. A failing file is counted & reported without
+ * stopping the run.
+ *
+ * For each input file `<dir>/<sub>/<name>.<ext>` (text, binary or compressed), the evaluation of the
+ * interpolators on a regular grid of the data range is written to `<output>/<sub>/<name>.txt`, one
+ * `x y_1 ... y_k` row per sample.
+ *
+ * @tparam T datapoints type (float, double, long double)
+ */
+template <typename T>
+class BatchProcessor {
+
+    private:
+        /* Interpolation schemes & cubic spline options */
+        std::vector<std::string> _interpolators;
+        std::vector<std::string> _options;
+
+        /* Number of grid samples evaluated per file */
+        Eigen::Index _samples;
+
+        /* Number of workers */
+        std::size_t _workers;
+
+        /* Reads, fits, evaluates & writes a single file, returns its number of datapoints */
+        Eigen::Index _process(const std::filesystem::path& file, const std::filesystem::path& output) const;
+
+    public:
+        /**
+         * @brief Construct a new Batch Processor object
+         *
+         * @param interpolators interpolation schemes (lagrange, barycentric, cubic_spline)
+         * @param options cubic spline options
+         * @param samples number of grid samples evaluated per file
+         * @param workers number of worker threads
+         */
+        BatchProcessor(const std::vector<std::string>& interpolators, const std::vector<std::string>& options,
+                       Eigen::Index samples, std::size_t workers);
+
+        /**
+         * @brief Lists the regular (non hidden) files of a directory and of its subdirectories, sorted by path
+         *
+         * @param dir data directory
+         * @return std::vector<std::filesystem::path> data files
+         */
+        static std::vector<std::filesystem::path> discover(const std::filesystem::path& dir);
+
+        /**
+         * @brief Get the output file of an input file, mirroring its place within dir into output_dir
+         *
+         * @param file input data file (within dir)
+         * @param dir data directory
+         * @param output_dir output directory
+         */
+        static std::filesystem::path output_path(const std::filesystem::path& file, const std::filesystem::path& dir,
+                                                 const std::filesystem::path& output_dir);
+
+        /**
+         * @brief Processes every data file of dir and writes the results to output_dir. Files
+         * sharing an output path (e.g. a.txt & a.bin) are not processed and count as failed.
+         *
+         * @param dir data directory
+         * @param output_dir output directory (created if needed)
+         * @return BatchSummary counters of the run
+         */
+        BatchSummary run(const std::filesystem::path& dir, const std::filesystem::path& output_dir) const;
+};
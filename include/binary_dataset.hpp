@@ -0,0 +1,182 @@
+/**
+ * @file binary_dataset.hpp
+ * @brief Versioned binary dataset format, memory mapped for zero-copy loading
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstdint>
+#include <filesystem>
+
+/* Magic bytes starting every binary dataset file */
+#define BINARY_DATASET_MAGIC "IPDS"
+
+/* Current version of the binary dataset format */
+#define BINARY_DATASET_VERSION 1
+
+/**
+ * @brief Datatype of the values stored in a binary dataset
+ *
+ */
+enum class DatasetType : std::uint8_t {
+    INT32 = 0,
+    FLOAT32 = 1,
+    FLOAT64 = 2,
+    LONG_DOUBLE = 3,
+};
+
+/**
+ * @brief Memory layout of the values stored in a binary dataset
+ *
+ */
+enum class DatasetLayout : std::uint8_t {
+    COL_MAJOR = 0,
+};
+
+/**
+ * @brief Header of a binary dataset file. It is followed by the rows x cols values
+ * in the given layout. The header is 64 bytes long so the data stays aligned in the mapping.
+ *
+ */
+struct BinaryDatasetHeader {
+    char magic[4];
+    std::uint16_t version;
+    DatasetType dtype;
+    DatasetLayout layout;
+    std::uint32_t element_size;
+    std::uint32_t reserved_0;
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint8_t reserved_1[32];
+};
+static_assert(sizeof(BinaryDatasetHeader) == 64, "Binary dataset header must be 64 bytes");
+
+/**
+ * @brief Get the dataset type corresponding to the template type T
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ * @return DatasetType matching type
+ */
+template <typename T>
+DatasetType dataset_type();
+template <> DatasetType dataset_type<int>();
+template <> DatasetType dataset_type<float>();
+template <> DatasetType dataset_type<double>();
+template <> DatasetType dataset_type<long double>();
+
+/**
+ * @brief Get the size of the values of a dataset type
+ *
+ * @param dtype stored type
+ * @return std::uint32_t size in bytes (0 for an unknown type)
+ */
+std::uint32_t dataset_type_size(DatasetType dtype);
+
+/**
+ * @brief Builds the header of a binary dataset of rows x cols values of type T
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ * @param rows number of rows (N datapoints)
+ * @param cols number of columns (M dimensions)
+ * @return BinaryDatasetHeader the file header
+ */
+template <typename T>
+BinaryDatasetHeader make_binary_dataset_header(std::uint64_t rows, std::uint64_t cols);
+
+/**
+ * @brief Checks if the file at the given path starts with the binary dataset magic bytes
+ *
+ * @param path filepath
+ * @return true if the file is a binary dataset
+ */
+bool is_binary_dataset(const std::filesystem::path& path);
+
+/**
+ * @brief Reads & validates the header of a binary dataset file
+ *
+ * @param path filepath
+ * @return BinaryDatasetHeader the file header
+ */
+BinaryDatasetHeader read_binary_dataset_header(const std::filesystem::path& path);
+
+/**
+ * @brief Read-only memory mapping of a binary dataset. The data is never copied, the
+ * matrix returned by matrix() points directly into the mapping and is only valid
+ * while the object lives.
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+class MappedDataset {
+
+    private:
+        /* Mapped file */
+        boost::iostreams::mapped_file_source _file;
+
+        /* Dataset header */
+        BinaryDatasetHeader _header;
+
+    public:
+        /**
+         * @brief Maps the binary dataset at the given path (the stored type must be T)
+         *
+         * @param path filepath
+         */
+        explicit MappedDataset(const std::filesystem::path& path);
+
+        /**
+         * @brief Get the mapped data as a matrix (no copy)
+         *
+         * @return Eigen::Map<const Eigen::MatrixX<T>> view over the mapping
+         */
+        Eigen::Map<const Eigen::MatrixX<T>> matrix() const;
+
+        /**
+         * @brief Get the number of rows (N datapoints)
+         */
+        Eigen::Index rows() const { return this->_header.rows; }
+
+        /**
+         * @brief Get the number of columns (M dimensions)
+         */
+        Eigen::Index cols() const { return this->_header.cols; }
+};
+
+/**
+ * @brief Reader & writer for the binary dataset format
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+struct BinaryDataset {
+
+    /**
+     * @brief Writes the data as a binary dataset
+     *
+     * @param path filepath
+     * @param data datapoints to write
+     */
+    static void write(const std::filesystem::path& path, const Eigen::MatrixX<T>& data);
+
+    /**
+     * @brief Maps a binary dataset without copying (the stored type must be T)
+     *
+     * @param path filepath
+     * @return MappedDataset<T> mapping of the dataset
+     */
+    static MappedDataset<T> map(const std::filesystem::path& path);
+
+    /**
+     * @brief Reads a binary dataset into a matrix, converting the stored type to T if needed
+     *
+     * @param path filepath
+     * @return Eigen::MatrixX<T> Datapoints
+     */
+    static Eigen::MatrixX<T> read(const std::filesystem::path& path);
+};
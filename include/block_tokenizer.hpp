@@ -0,0 +1,89 @@
+/**
+ * @file block_tokenizer.hpp
+ * @brief Whitespace tokenizer reading an input stream in large blocks
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <istream>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+/* Default size of the blocks read from the underlying stream (1 MiB) */
+#define DEFAULT_TOKENIZER_BLOCK_SIZE (1 << 20)
+
+/**
+ * @brief Splits an input stream into whitespace separated tokens.
+ *
+ * The stream is read in blocks of fixed size into an internal buffer and tokens
+ * are returned as views into that buffer, no per-token allocation is made.
+ * Tokens straddling two blocks are moved to the front of the buffer before
+ * reading the next block.
+ */
+class BlockTokenizer {
+
+    private:
+        /* Stream the tokens are read from */
+        std::istream& _stream;
+
+        /* Internal read buffer */
+        std::vector<char> _buffer;
+
+        /* Size of the blocks read from the stream */
+        std::size_t _block_size;
+
+        /* Current read position & end of valid data in the buffer */
+        std::size_t _pos = 0;
+        std::size_t _end = 0;
+
+        /* Total number of bytes read from the stream */
+        std::size_t _bytes_read = 0;
+
+        /**
+         * @brief Reads the next block from the stream, keeping the unconsumed bytes starting at keep_from
+         *
+         * @param keep_from Index of the first byte of the buffer to be kept
+         * @return true if new data was read
+         */
+        bool _refill(std::size_t keep_from);
+
+    public:
+        /**
+         * @brief Construct a new Block Tokenizer object
+         *
+         * @param stream Stream to read the tokens from
+         * @param block_size Size of the blocks read from the stream
+         */
+        explicit BlockTokenizer(std::istream& stream, std::size_t block_size = DEFAULT_TOKENIZER_BLOCK_SIZE);
+
+        /**
+         * @brief Get the next whitespace separated token
+         *
+         * @return std::string_view token, empty at the end of the stream. The view is only
+         * valid until the next call.
+         */
+        std::string_view next();
+
+        /**
+         * @brief Get the number of bytes read from the stream so far
+         *
+         * @return std::size_t number of bytes
+         */
+        std::size_t bytes_read() const { return this->_bytes_read; }
+
+        /**
+         * @brief Converts a whole token to a number using std::from_chars
+         *
+         * @tparam T numeric type (int, float, double, long double)
+         * @param token Token to convert
+         * @param value Converted value (only written on success)
+         * @return true if the complete token is a valid number
+         */
+        template <typename T>
+        static bool parse(std::string_view token, T& value);
+};
@@ -0,0 +1,89 @@
+/**
+ * @file bounded_queue.hpp
+ * @brief Blocking FIFO queue with a maximum capacity, used between pipelined stages
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/**
+ * @brief Thread-safe FIFO queue holding at most `capacity` items.
+ *
+ * push() blocks while the queue is full and pop() blocks while it is empty, so a fast
+ * producer can never get more than `capacity` items ahead of its consumer. Once closed,
+ * push() drops the items and pop() drains the remaining ones before returning std::nullopt.
+ *
+ * @tparam V item type
+ */
+template <typename V>
+class BoundedQueue {
+
+    private:
+        std::deque<V> _items;
+        std::size_t _capacity;
+        bool _closed = false;
+        std::mutex _mutex;
+        std::condition_variable _not_full;
+        std::condition_variable _not_empty;
+
+    public:
+        /**
+         * @brief Construct a new Bounded Queue object
+         *
+         * @param capacity maximum number of queued items (at least 1)
+         */
+        explicit BoundedQueue(std::size_t capacity)
+            : _capacity(capacity > 0 ? capacity : 1) {}
+
+        /**
+         * @brief Adds an item, waiting for a free slot if the queue is full
+         *
+         * @param item item to add
+         * @return true if the item was queued, false if the queue was closed
+         */
+        bool push(V item)
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_not_full.wait(lock, [this] { return this->_closed || this->_items.size() < this->_capacity; });
+            if (this->_closed) { return false; }
+            this->_items.push_back(std::move(item));
+            this->_not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest item, waiting for one if the queue is empty
+         *
+         * @return std::optional<V> the item, std::nullopt once the queue is closed & empty
+         */
+        std::optional<V> pop()
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_not_empty.wait(lock, [this] { return this->_closed || !this->_items.empty(); });
+            if (this->_items.empty()) { return std::nullopt; }
+            V item = std::move(this->_items.front());
+            this->_items.pop_front();
+            this->_not_full.notify_one();
+            return item;
+        }
+
+        /**
+         * @brief Closes the queue, waking up all the waiting producers & consumers
+         */
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_closed = true;
+            this->_not_full.notify_all();
+            this->_not_empty.notify_all();
+        }
+};
@@ -0,0 +1,125 @@
+/**
+ * @file chunked_reader.hpp
+ * @brief Streaming reader yielding fixed-size row chunks of a data file
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include "binary_dataset.hpp"
+#include "block_tokenizer.hpp"
+#include "interpolator.hpp"
+
+/* Default number of rows per chunk */
+#define DEFAULT_CHUNK_ROWS (1 << 16)
+
+/**
+ * @brief Reads a text or binary data file by chunks of rows, so the memory used stays
+ * bounded by the chunk size whatever the size of the file.
+ *
+ * Text files (optionally gzip/zstd compressed) are tokenized block by block, binary
+ * datasets are memory mapped and only the requested rows are copied (and converted to T if needed).
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+class ChunkedReader {
+
+    private:
+        /* Owned text file stream (unused for binary or external streams) */
+        std::unique_ptr<std::istream> _owned_stream;
+
+        /* Tokenizer of the text source */
+        std::unique_ptr<BlockTokenizer> _tokenizer;
+
+        /* Mapping of the binary source */
+        boost::iostreams::mapped_file_source _mapping;
+
+        /* Header of the binary source */
+        BinaryDatasetHeader _header;
+
+        /* True if reading from a binary dataset */
+        bool _binary = false;
+
+        /* Datasize (N,M) */
+        Eigen::Index _rows = 0;
+        Eigen::Index _cols = 0;
+
+        /* Next row to be read */
+        Eigen::Index _next_row = 0;
+
+        /* Maximum number of rows per chunk */
+        Eigen::Index _chunk_rows;
+
+        /* Copies the rows [first, first+chunk.rows()) of the binary source stored as U into chunk */
+        template <typename U>
+        void _copy_binary_rows(Eigen::MatrixX<T>& chunk, Eigen::Index first) const;
+
+        /* Reads the parameter line of the text source */
+        void _open_text(std::istream& stream);
+
+    public:
+        /**
+         * @brief Opens a text or binary data file (detected from the magic bytes)
+         *
+         * @param path filepath
+         * @param chunk_rows maximum number of rows per chunk
+         */
+        explicit ChunkedReader(const std::filesystem::path& path, Eigen::Index chunk_rows = DEFAULT_CHUNK_ROWS);
+
+        /**
+         * @brief Reads text data from an already opened stream (e.g. std::cin). The stream must
+         * outlive the reader.
+         *
+         * @param stream input stream in the text format
+         * @param chunk_rows maximum number of rows per chunk
+         */
+        explicit ChunkedReader(std::istream& stream, Eigen::Index chunk_rows = DEFAULT_CHUNK_ROWS);
+
+        /**
+         * @brief Reads the next chunk of rows
+         *
+         * @param chunk resized to min(chunk_rows, remaining rows) x M and filled with the datapoints
+         * @return true if a chunk was read, false once all the rows were read
+         */
+        bool next(Eigen::MatrixX<T>& chunk);
+
+        /**
+         * @brief Get the total number of rows (N datapoints) of the source
+         */
+        Eigen::Index rows() const { return this->_rows; }
+
+        /**
+         * @brief Get the number of columns (M dimensions) of the source
+         */
+        Eigen::Index cols() const { return this->_cols; }
+
+        /**
+         * @brief Get the number of rows already read
+         */
+        Eigen::Index rows_read() const { return this->_next_row; }
+};
+
+/**
+ * @brief Evaluates an interpolator on every chunk of a reader without loading the whole source.
+ *
+ * @tparam T datapoints type
+ * @param interpolator fitted interpolator
+ * @param reader reader over the queries (column query_dim is interpolated)
+ * @param sink called with every chunk and the corresponding interpolated values
+ * @param query_dim column of the chunks used as query points
+ * @return Eigen::Index total number of evaluated queries
+ */
+template <typename T>
+Eigen::Index evaluate_chunks(Interpolator<T>& interpolator, ChunkedReader<T>& reader,
+                             const std::function<void(const Eigen::MatrixX<T>&, const Eigen::VectorX<T>&)>& sink,
+                             unsigned int query_dim = 0);
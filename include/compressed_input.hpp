@@ -0,0 +1,115 @@
+/**
+ * @file compressed_input.hpp
+ * @brief Transparent decompression of gzip/zstd data files, decoded on a background thread
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <exception>
+#include <filesystem>
+#include <istream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+#include "bounded_queue.hpp"
+
+/* Size of the decompressed blocks handed to the parser (1 MiB) */
+#define DECOMPRESSION_BLOCK_SIZE (1 << 20)
+
+/* Number of decompressed blocks the decoder may get ahead of the parser */
+#define DECOMPRESSION_QUEUE_SIZE 4
+
+/**
+ * @brief Compression of a data file
+ *
+ */
+enum class Compression {
+    NONE,
+    GZIP,
+    ZSTD,
+};
+
+/**
+ * @brief Detects the compression of a file from its magic bytes, falling back on
+ * its extension (.gz, .zst) only if the file is missing or too short to hold them
+ *
+ * @param path filepath
+ * @return Compression detected compression
+ */
+Compression detect_compression(const std::filesystem::path& path);
+
+/**
+ * @brief Checks if zstd support was compiled in (INTERPOLATION_HAVE_ZSTD)
+ *
+ * @return true if .zst files can be read
+ */
+bool zstd_supported();
+
+/**
+ * @brief Stream buffer handing out blocks decompressed by a background thread.
+ *
+ * The decoder thread runs the Boost.Iostreams decompressor and pushes fixed-size
+ * blocks into a bounded queue, so decoding the next blocks overlaps with parsing
+ * the current one. Decoding errors are rethrown by the reading thread.
+ */
+class DecompressingBuffer: public std::streambuf {
+
+    private:
+        /* Decompressed blocks waiting to be parsed (an empty block marks the end) */
+        BoundedQueue<std::vector<char>> _blocks;
+
+        /* Block currently exposed as the get area */
+        std::vector<char> _current;
+
+        /* Error raised by the decoder thread */
+        std::exception_ptr _error;
+
+        /* Set once the end of the data was reached */
+        bool _finished = false;
+
+        /* Decoder thread */
+        std::thread _decoder;
+
+        /* Decoder thread body */
+        void _decode(std::filesystem::path path, Compression compression);
+
+    protected:
+        int_type underflow() override;
+
+    public:
+        /**
+         * @brief Starts decoding the given file
+         *
+         * @param path compressed filepath
+         * @param compression compression of the file
+         */
+        DecompressingBuffer(const std::filesystem::path& path, Compression compression);
+
+        /**
+         * @brief Stops the decoder thread
+         */
+        ~DecompressingBuffer();
+};
+
+/**
+ * @brief Input stream over the decompressed content of a gzip/zstd file
+ *
+ */
+class DecompressingStream: public std::istream {
+
+    private:
+        DecompressingBuffer _buffer;
+
+    public:
+        /**
+         * @brief Opens the compressed file for reading
+         *
+         * @param path compressed filepath
+         * @param compression compression of the file
+         */
+        DecompressingStream(const std::filesystem::path& path, Compression compression);
+};
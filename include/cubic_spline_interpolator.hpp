@@ -15,15 +15,21 @@
 #include "polynomial_interpolator.hpp"
 #include "project_exceptions.hpp"
 #include <iostream>
-#include <Eigen/LU>
 
 /**
  * @brief Templated class for cubic spline interpolation
  * 
- * @tparam T 
+ * With a narrower storage type S (CubicSplineInterpolator<double, float>), the knots, values &
+ * coefficients are stored as float: the spline is fitted in double on the float-rounded knots &
+ * values and evaluated in double, only its coefficients being rounded to float. The deviation from
+ * the double model is about 2^-24 (max|y| + max|x| max|y'|), as for BarycentricInterpolator<double, float>
+ * (measured 1.1e-7 max|y| for exp(x) sin(5x) + 2 and 1.1e-6 for cos(30x)).
+ * 
+ * @tparam T datapoints type (float, double)
+ * @tparam S storage type of the knots, values & coefficients (T by default)
  */
-template <typename T>
-class CubicSplineInterpolator: public PolynomialInterpolator<T>
+template <typename T, typename S = T>
+class CubicSplineInterpolator: public PolynomialInterpolator<T, S>
 {
     public:
         /**
@@ -51,7 +57,7 @@ class CubicSplineInterpolator: public PolynomialInterpolator<T>
          * \f]
          * where a_i, b_i, c_i, and d_i are the coefficients for the i-th cubic segment.
          */
-        Eigen::MatrixX4<T> coefficients; 
+        Eigen::MatrixX4<S> coefficients; 
 
         /**
          * @brief The values to clamp the spline to if the boundary condition is set to CLAMPED
@@ -59,23 +65,36 @@ class CubicSplineInterpolator: public PolynomialInterpolator<T>
         Eigen::Vector2<T> clamped_values;
 
         /**
-         * @brief Private function for applying the boundary conditions for the trilinear system matrix A and the vector b. 
+         * @brief Private function for applying the boundary conditions to the first & last rows of the tridiagonal system A c = b.
          * Ex: NATURAL boundary conditions impose A_{11}=A_{nn}=1 and b_1=b_n=0
          * 
-         * @param A : The trilinear system matrix
-         * @param b : The trilinear system vector
+         * @param lower : The sub-diagonal of A (lower[i] = A_{i,i-1})
+         * @param diag : The diagonal of A
+         * @param upper : The super-diagonal of A (upper[i] = A_{i,i+1})
+         * @param b : The tridiagonal system vector
          * @param f : Newton's divided differences `f[i] = (y[i+1] - y[i]) / h[i]\`
          * @param h : The datapoint difference vector  `h[i] = x[i+1] - x[i]`
          */
-        void _apply_boundary_conditions(Eigen::MatrixX<T> &A, Eigen::VectorX<T> &b, Eigen::VectorX<T> &f, Eigen::VectorX<T> &h);
+        void _apply_boundary_conditions(Eigen::Ref<Eigen::VectorX<T>> lower, Eigen::Ref<Eigen::VectorX<T>> diag,
+                                        Eigen::Ref<Eigen::VectorX<T>> upper, Eigen::Ref<Eigen::VectorX<T>> b,
+                                        const Eigen::Ref<const Eigen::VectorX<T>>& f, const Eigen::Ref<const Eigen::VectorX<T>>& h);
+
+        /**
+         * @brief Fits the spline on the knots X & values y, the temporaries being drawn from the scratch arena
+         * 
+         * @param X : The knots (ascending)
+         * @param y : The values at the knots
+         */
+        void _fit(const Eigen::Ref<const Eigen::VectorX<T>>& X, const Eigen::Ref<const Eigen::VectorX<T>>& y);
 
+    protected:
         /**
-         * @brief A private method to identify the index of the segment (or 'bin') that contains the value x.
+         * @brief Evaluates the spline segment containing x (no range check)
          * 
-         * @param x : The value to find the segment for
-         * @return int : The index of the bin
+         * @param x : The datapoint to evaluate
+         * @return T : The spline value at x
          */
-        int _get_index(T x);
+        T _evaluate(T x) final;
 
     public:
 
@@ -110,7 +129,7 @@ class CubicSplineInterpolator: public PolynomialInterpolator<T>
 
         /**
          * @brief Fit the data to the cubic spline interpolator using the specified X and y data. 
-         * Computes the coefficients for the cubic spline by solving a trilinear system of equations.
+         * Computes the coefficients for the cubic spline by solving a tridiagonal system of equations in O(n).
          * 
          * @param X : The datapoints to fit the spline to 
          * @param y : The values of the datapoints to fit the spline to
@@ -123,7 +142,7 @@ class CubicSplineInterpolator: public PolynomialInterpolator<T>
          * @param X : The datapoints to query the interpolator for
          * @return Eigen::VectorX<T> : The interpolated values at the specified datapoints
          */
-        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) override;
+        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) final;
 
         /**
          * @brief Query the cubic spline interpolator for the interpolated value at the specified datapoint x
@@ -131,7 +150,7 @@ class CubicSplineInterpolator: public PolynomialInterpolator<T>
          * @param x : The datapoint to query the interpolator for
          * @return T : The interpolated value at the specified datapoint
          */
-        T operator()(T x) override;
+        T operator()(T x) final;
 
         /**
          * @brief Set the clamped values object for CLAMPED boundary conditions
@@ -148,6 +167,27 @@ class CubicSplineInterpolator: public PolynomialInterpolator<T>
          */
         void set_clamped_values(T low, T high);
 
+        /**
+         * @brief Get the (n-1) x 4 coefficients (a, b, c, d) of the fitted segments
+         * 
+         * @return const Eigen::MatrixX4<S>& : The spline coefficients
+         */
+        const Eigen::MatrixX4<S>& get_coefficients() const;
+
+        /**
+         * @brief Get the boundary condition applied by the spline
+         * 
+         * @return BoundaryConstraint : The boundary condition
+         */
+        BoundaryConstraint get_boundary_constraint() const;
+
+        /**
+         * @brief Get the clamped values used with CLAMPED boundary conditions
+         * 
+         * @return const Eigen::Vector2<T>& : The clamped values (lower, upper)
+         */
+        const Eigen::Vector2<T>& get_clamped_values() const;
+
 };
 
 #endif
\ No newline at end of file
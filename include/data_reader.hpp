@@ -4,6 +4,8 @@
 #include <filesystem>
 #include <fstream>
 #include "interpolator.hpp"
+#include "block_tokenizer.hpp"
+#include <utility>
 
 /**
  * @brief Generic reader class to read datapoints from fromatted .txt files 
@@ -22,7 +24,9 @@ template <typename T>
 struct DataReader { 
 
     /**
-     * @brief Reads a file containing the data to be interpolated (expects right format)
+     * @brief Reads a file containing the data to be interpolated (expects right format).
+     * Binary datasets (see binary_dataset.hpp) are detected from their magic bytes and loaded without parsing,
+     * gzip/zstd compressed text files are decompressed on a background thread while being parsed.
      * 
      * @param path filepath
      * @return Eigen::MatrixX<T> Datapoints
@@ -37,13 +41,51 @@ struct DataReader {
      */
     static Eigen::MatrixX<T> read(std::ifstream &file);
 
+    /**
+     * @brief Reads the data to be interpolated from any input stream. The stream is read in large
+     * blocks and the values are converted with std::from_chars directly into the data matrix.
+     * 
+     * @param stream input stream to be read from
+     * @return Eigen::MatrixX<T> Datapoints
+     */
+    static Eigen::MatrixX<T> read(std::istream &stream);
+
+    /**
+     * @brief Reads the '# N M' parameter line of a text data file
+     * 
+     * @param tokenizer tokenizer positioned at the start of the file
+     * @return std::pair<Eigen::Index, Eigen::Index> datasize (N,M)
+     */
+    static std::pair<Eigen::Index, Eigen::Index> read_header(BlockTokenizer &tokenizer);
+
+    /**
+     * @brief Reads the next data.rows() datapoints of a text data file into data
+     * 
+     * @param tokenizer tokenizer positioned after the parameter line or the last read datapoint
+     * @param data preallocated matrix to fill (rows x M)
+     */
+    static void read_rows(BlockTokenizer &tokenizer, Eigen::MatrixX<T> &data);
+
     /**
      * @brief Reads a file containing the data and the interpolation method to directly generate
      * appropriate interpolator object
      * 
+     * The file is parsed only once and shared through DatasetCache<T>::global().
+     * 
      * @param path filepath
      * @return Interpolator<T> the requested interpolator object 
      */
-    static std::unique_ptr<Interpolator<T>> interpolator_from_file(const std::filesystem::path& path, const std::string& interpolator, std::vector<std::string>& options, const int fitting_dim);
+    static std::unique_ptr<Interpolator<T>> interpolator_from_file(const std::filesystem::path& path, const std::string& interpolator, const std::vector<std::string>& options, const int fitting_dim);
+
+    /**
+     * @brief Generates the requested interpolator object fitted on already loaded datapoints
+     * 
+     * @param X datapoints (N x M)
+     * @param interpolator interpolation scheme (lagrange, barycentric, cubic_spline)
+     * @param options extra parameters of the interpolation scheme
+     * @param fitting_dim column of X used as the interpolated dimension
+     * @return Interpolator<T> the requested interpolator object 
+     */
+    static std::unique_ptr<Interpolator<T>> interpolator_from_data(const Eigen::MatrixX<T>& X, const std::string& interpolator, const std::vector<std::string>& options, const int fitting_dim);
 
 };
\ No newline at end of file
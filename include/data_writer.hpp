@@ -0,0 +1,122 @@
+/**
+ * @file data_writer.hpp
+ * @brief High-throughput writer for the text & binary data formats
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+/* Minimum number of rows formatted by each thread (smaller chunks are formatted by fewer threads) */
+#define MIN_WRITER_ROWS_PER_THREAD 4096
+
+/**
+ * @brief Output format of the written data
+ *
+ */
+enum class DataFormat {
+    TEXT,       ///< '# N M' parameter line followed by N lines of M space separated values
+    BINARY,     ///< Binary dataset (see binary_dataset.hpp)
+};
+
+/**
+ * @brief Writes N x M datapoints to a file, either at once or streamed by chunks of rows.
+ *
+ * Text values are formatted with std::to_chars into large buffers (no iostream formatting,
+ * no flush per line). With more than one thread, each chunk is split in contiguous row
+ * ranges formatted in parallel and written back in order, so the output does not depend
+ * on the number of threads.
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+class DataWriter {
+
+    private:
+        /* Output file */
+        std::ofstream _file;
+
+        /* Output filepath */
+        std::filesystem::path _path;
+
+        /* Output format */
+        DataFormat _format;
+
+        /* Number of significant digits (< 0 for the shortest exact representation) */
+        int _precision;
+
+        /* Number of formatting threads */
+        unsigned int _threads;
+
+        /* Datasize (N,M) & number of rows already written */
+        Eigen::Index _rows;
+        Eigen::Index _cols;
+        Eigen::Index _written = 0;
+
+        /* Formatting buffers, one per thread */
+        std::vector<std::vector<char>> _buffers;
+
+        /* Formats the rows [first, last) of chunk as text into buffer, returns the number of chars written */
+        std::size_t _format_rows(const Eigen::MatrixX<T>& chunk, Eigen::Index first, Eigen::Index last, std::vector<char>& buffer) const;
+
+        /* Writes the chunk as text */
+        void _write_text(const Eigen::MatrixX<T>& chunk);
+
+        /* Writes the chunk at its place in every column of the preallocated binary file */
+        void _write_binary(const Eigen::MatrixX<T>& chunk);
+
+    public:
+        /**
+         * @brief Opens the file and writes the header for rows x cols datapoints
+         *
+         * @param path output filepath
+         * @param rows total number of rows (N datapoints) to be written
+         * @param cols number of columns (M dimensions)
+         * @param format output format
+         * @param precision number of significant digits for text output (< 0 for the shortest exact representation)
+         * @param threads number of threads formatting the text output
+         */
+        DataWriter(const std::filesystem::path& path, Eigen::Index rows, Eigen::Index cols,
+                   DataFormat format = DataFormat::TEXT, int precision = -1, unsigned int threads = 1);
+
+        /**
+         * @brief Closes the file (without checking the number of written rows)
+         */
+        ~DataWriter();
+
+        /**
+         * @brief Appends the rows of chunk to the file
+         *
+         * @param chunk datapoints (K x M) following the already written rows
+         */
+        void write_rows(const Eigen::MatrixX<T>& chunk);
+
+        /**
+         * @brief Flushes & closes the file, checking that all the announced rows were written
+         */
+        void close();
+
+        /**
+         * @brief Get the number of rows already written
+         */
+        Eigen::Index rows_written() const { return this->_written; }
+
+        /**
+         * @brief Writes all the datapoints at once
+         *
+         * @param path output filepath
+         * @param data datapoints (N x M)
+         * @param format output format
+         * @param precision number of significant digits for text output (< 0 for the shortest exact representation)
+         * @param threads number of threads formatting the text output
+         */
+        static void write(const std::filesystem::path& path, const Eigen::MatrixX<T>& data,
+                          DataFormat format = DataFormat::TEXT, int precision = -1, unsigned int threads = 1);
+};
@@ -18,6 +18,12 @@
 #include <vector>
 #include <utility>
 #include <iostream>
+#include <functional>
+#include "data_writer.hpp"
+#include "random_generator.hpp"
+
+/* Number of rows generated & written at once by random_data */
+#define DATAGEN_CHUNK_ROWS (1 << 16)
 
 // #ifndef DATAGEN_HPP 
 // #define DATAGEN_HPP
@@ -40,9 +46,56 @@ struct datagen {
         UNIFORM,
     };
 
+    /**
+     * @brief Layout of the points of a multi-dimensional domain.
+     * 
+     */
+    enum class PointSet {
+        TENSOR,     ///< Cartesian product of one 1D point set (PointGeneration) per dimension
+        SCATTERED,  ///< Independent uniform random points in the domain box
+    };
+
+    /**
+     * @brief Multi-dimensional point set specification. The rows of the generated data are
+     * the points, so any range of rows can be generated independently (see generate_points).
+     * 
+     */
+    struct PointSpec {
+        /* Range of each dimension (M dimensions) */
+        std::vector<std::pair<T, T>> range;
+        /* TENSOR: number of points per dimension (dimension 0 varies fastest), SCATTERED: total number of points */
+        std::vector<int> points;
+        /* Layout of the points */
+        PointSet set = PointSet::TENSOR;
+        /* 1D point generation of every tensor axis */
+        PointGeneration pg = PointGeneration::UNIFORM;
+        /* Seed of the random points */
+        std::uint64_t seed = DEFAULT_RANDOM_SEED;
+
+        /**
+         * @brief Number of points (rows) of the set
+         */
+        Eigen::Index size() const;
+    };
+
+    /**
+     * @brief Term c x_1^{e_1} x_2^{e_2} ... x_M^{e_M} of a multivariate polynomial. Missing exponents are 0.
+     * 
+     */
+    struct Monomial {
+        T coeff;
+        std::vector<int> exponents;
+    };
+
+    /**
+     * @brief Function evaluated on a chunk of points X (K x M) into y (K)
+     * 
+     */
+    using Function = std::function<void(const Eigen::MatrixX<T>& X, Eigen::VectorX<T>& y)>;
+
     /**
      * @brief Write the data to a file at the specified path. It is space separated and newline delimited. The first rows start with a '#' and contain metadata, such as the dimensions of the data.
-     * TODO: be more specific about the format of the data, once we have chosen the convention. 
+     * Values are written with their shortest exact representation (see DataWriter).
      * 
      * @param path : The path to write the data to
      * @param data : The data to write
@@ -50,23 +103,47 @@ struct datagen {
     static void write(const std::filesystem::path path, const Eigen::MatrixX<T> &data);
 
     /**
-     * @brief Generate random data of size n \times m and write it to the specified path.
+     * @brief Generate uniform random data in [-1, 1) of size n \times m and write it to the specified path.
+     * The rows are generated & written by chunks in parallel, the file only depends on the seed.
      * 
      * @param path : The path to write the data to
      * @param n : The number of rows
      * @param m : The number of columns
+     * @param seed : The seed of the random values
+     */
+    static void random_data(std::filesystem::path path, int n, int m, std::uint64_t seed = DEFAULT_RANDOM_SEED);
+
+    /**
+     * @brief The multi-dimensional counterpart to the polynomial method.
+     * \f[
+     * f(x) = \sum_k c_k \prod_{d=1}^M x_d^{e_{k,d}}
+     * \f]
+     * 
+     * @param data : Resized to N \times (M+1), the points (data.leftCols(M)) followed by the polynomial values (data.col(M))
+     * @param terms : The terms of the polynomial
+     * @param spec : The points of the domain
+     */
+    static void polynomial(Eigen::MatrixX<T> &data, const std::vector<Monomial> &terms, const PointSpec &spec);
+
+    /**
+     * @brief Stream the multi-dimensional polynomial to the specified path, without holding the whole table in memory.
+     * 
+     * @param path : The path to write the data to
+     * @param terms : The terms of the polynomial
+     * @param spec : The points of the domain
+     * @param format : The output format
      */
-    static void random_data(std::filesystem::path path, int n, int m);
+    static void polynomial(const std::filesystem::path &path, const std::vector<Monomial> &terms, const PointSpec &spec, DataFormat format = DataFormat::TEXT);
 
     /**
-     * @brief The multi-dimensional polynomial counterpart to the polynomial method. **Unsuppported**
+     * @brief Helper function evaluating a multivariate polynomial on a set of points.
+     * The powers of every dimension are computed once and shared by all the terms.
      * 
-     * @param data 
-     * @param coeffs 
-     * @param range 
-     * @param pg 
+     * @param y : Resized to K and populated with the polynomial values
+     * @param X : The points (K x M)
+     * @param terms : The terms of the polynomial
      */
-    static void polynomial(Eigen::MatrixX<T> &data, Eigen::VectorX<T> &coeffs, std::vector<std::pair<T, T>> range, PointGeneration pg);
+    static void polynomial(Eigen::VectorX<T> &y, const Eigen::MatrixX<T> &X, const std::vector<Monomial> &terms);
 
     /**
      * @brief Generate a polynomial function of the specified coefficients and write it to the specified path. 
@@ -89,6 +166,7 @@ struct datagen {
     
     /**
      * @brief Helper function to generate a polynomial function of the specified coefficients and populate the data vector with the values.
+     * The polynomial is evaluated in Horner form.
      * 
      * @param data : The vector to populate with the polynomial values
      * @param x : The domain of the polynomial
@@ -102,8 +180,37 @@ struct datagen {
      * @param x : The vector to populate with the points
      * @param range : The range of the data to generate
      * @param pg : The point generation paradigm to use
+     * @param seed : The seed of the RANDOM_UNIFORM points
+     */
+    static void generate_points(Eigen::VectorX<T> &x, std::pair<T, T> range, PointGeneration pg, std::uint64_t seed = DEFAULT_RANDOM_SEED);
+
+    /**
+     * @brief Generate the rows [first_row, first_row + X.rows()) of a multi-dimensional point set.
+     * 
+     * @param X : The points to populate (resized to X.rows() x M)
+     * @param spec : The point set
+     * @param first_row : The index of the first generated point
+     */
+    static void generate_points(Eigen::MatrixX<T> &X, const PointSpec &spec, Eigen::Index first_row = 0);
+
+    /**
+     * @brief Tabulate a function on a point set: data = [X, f(X)], resized to N \times (M+1).
+     * 
+     * @param data : The data to populate
+     * @param spec : The points of the domain
+     * @param f : The function to tabulate
+     */
+    static void tabulate(Eigen::MatrixX<T> &data, const PointSpec &spec, const Function &f);
+
+    /**
+     * @brief Tabulate a function on a point set and stream the rows [X, f(X)] to the specified path by chunks.
+     * 
+     * @param path : The path to write the data to
+     * @param spec : The points of the domain
+     * @param f : The function to tabulate
+     * @param format : The output format
      */
-    static void generate_points(Eigen::VectorX<T> &x, std::pair<T, T> range, PointGeneration pg);
+    static void stream(const std::filesystem::path &path, const PointSpec &spec, const Function &f, DataFormat format = DataFormat::TEXT);
 
     /**
      * @brief Implementation of the Chebyshev points generation paradigm.
@@ -140,6 +247,37 @@ struct datagen {
      */
     static void damped_cosine(Eigen::MatrixX2<T> &data, Eigen::VectorX<T> &params, std::pair<T, T> range, PointGeneration pg);
 
+    /**
+     * @brief The radial, multi-dimensional counterpart to the damped cosine function.
+     * \f[
+     * f(x) = a e^{-b \|x\|^2} \cos(c \|x\|)
+     * \f]
+     * 
+     * @param data : Resized to N \times (M+1), the points (data.leftCols(M)) followed by the function values (data.col(M))
+     * @param params : The parameters (a, b, c) of the damped cosine function
+     * @param spec : The points of the domain
+     */
+    static void damped_cosine(Eigen::MatrixX<T> &data, const Eigen::VectorX<T> &params, const PointSpec &spec);
+
+    /**
+     * @brief Stream the multi-dimensional damped cosine function to the specified path.
+     * 
+     * @param path : The path to write the data to
+     * @param params : The parameters (a, b, c) of the damped cosine function
+     * @param spec : The points of the domain
+     * @param format : The output format
+     */
+    static void damped_cosine(const std::filesystem::path &path, const Eigen::VectorX<T> &params, const PointSpec &spec, DataFormat format = DataFormat::TEXT);
+
+    /**
+     * @brief Helper function evaluating the radial damped cosine function on a set of points.
+     * 
+     * @param y : Resized to K and populated with the function values
+     * @param X : The points (K x M)
+     * @param params : The parameters (a, b, c) of the damped cosine function
+     */
+    static void damped_cosine(Eigen::VectorX<T> &y, const Eigen::MatrixX<T> &X, const Eigen::VectorX<T> &params);
+
 };
 
 // #endif
\ No newline at end of file
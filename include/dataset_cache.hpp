@@ -0,0 +1,135 @@
+/**
+ * @file dataset_cache.hpp
+ * @brief Parse-once cache of the datasets read from files
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/* Default memory budget of the parsed datasets kept by a cache (256 MiB) */
+#define DEFAULT_DATASET_CACHE_BYTES (std::size_t(256) << 20)
+
+/**
+ * @brief Thread-safe cache of parsed data files.
+ *
+ * Entries are keyed by the canonical path of the file and are only reused while the
+ * file keeps the same modification time and size. Concurrent requests for the same file
+ * wait for a single parse. Once the parsed datasets exceed the memory budget, the least
+ * recently used ones are evicted (callers still holding them keep them alive).
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+class DatasetCache {
+
+    public:
+        /* Shared read-only dataset */
+        using Dataset = std::shared_ptr<const Eigen::MatrixX<T>>;
+
+    private:
+        /**
+         * @brief A cached dataset with the file state it was parsed from
+         */
+        struct Entry {
+            std::filesystem::file_time_type mtime;
+            std::uintmax_t size;
+            std::shared_future<Dataset> data;
+            std::uint64_t generation;           ///< Identifies the get() call parsing the entry
+            std::size_t bytes;                  ///< Memory used by the parsed dataset (0 while parsing)
+            std::list<std::string>::iterator lru;
+        };
+
+        /* Cached datasets keyed by canonical filepath */
+        std::unordered_map<std::string, Entry> _entries;
+
+        /* Keys from the most to the least recently used */
+        std::list<std::string> _lru;
+
+        /* Memory budget & memory used by the parsed datasets */
+        std::size_t _max_bytes;
+        std::size_t _bytes = 0;
+
+        /* Incremented for every parse started */
+        std::uint64_t _generation = 0;
+
+        /* Protects the entries & counters */
+        mutable std::mutex _mutex;
+
+        /* Number of lookups served from the cache / requiring a parse */
+        std::size_t _hits = 0;
+        std::size_t _misses = 0;
+
+        /**
+         * @brief Removes an entry (the caller must hold the lock)
+         */
+        void _erase(typename std::unordered_map<std::string, Entry>::iterator it);
+
+        /**
+         * @brief Evicts the least recently used datasets until the budget is met, never
+         * evicting the given key (the caller must hold the lock)
+         */
+        void _evict(const std::string& keep);
+
+    public:
+        /**
+         * @brief Construct a new cache
+         *
+         * @param max_bytes memory budget of the cached datasets
+         */
+        explicit DatasetCache(std::size_t max_bytes = DEFAULT_DATASET_CACHE_BYTES);
+
+        /**
+         * @brief Get the dataset stored in the file, parsing it only if not cached yet or if
+         * the file changed since it was cached
+         *
+         * @param path filepath (text or binary format)
+         * @return Dataset parsed datapoints
+         */
+        Dataset get(const std::filesystem::path& path);
+
+        /**
+         * @brief Removes all the cached datasets
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of cached datasets
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Get the memory used by the cached datasets
+         */
+        std::size_t bytes() const;
+
+        /**
+         * @brief Get the number of lookups served without parsing
+         */
+        std::size_t hits() const;
+
+        /**
+         * @brief Get the number of lookups which required parsing the file
+         */
+        std::size_t misses() const;
+
+        /**
+         * @brief Get the process wide cache used by the interpolator factory (default budget)
+         *
+         * @return DatasetCache<T>& global cache
+         */
+        static DatasetCache<T>& global();
+};
@@ -0,0 +1,252 @@
+/**
+ * @file fixed_interpolators.hpp
+ * @brief Barycentric & Lagrange interpolators through a compile-time number of nodes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * For small stencils (typically 4 to 16 nodes), the nodes, values & weights are stored in fixed-size
+ * Eigen vectors (no heap allocation), the weights & evaluation loops are unrolled at compile time and
+ * the queries are not virtual calls. The weights of nodes known at compile time can be computed by
+ * fixed_barycentric_weights() in a constant expression.
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "interpolator.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Barycentric weight of the node I, 1 / prod_{j != I} (x_I - x_j), as an unrolled product
+ */
+template <typename T, std::size_t N, std::size_t I, std::size_t... J>
+constexpr T fixed_barycentric_weight(const std::array<T, N>& nodes, std::index_sequence<J...>)
+{
+    return T(1) / ((J == I ? T(1) : nodes[I] - nodes[J]) * ...);
+}
+
+/**
+ * @brief Barycentric weights of N nodes, usable in constant expressions (duplicated nodes then
+ * fail to compile as a division by zero)
+ *
+ * @param nodes distinct nodes
+ * @return std::array<T, N> weights w_i = 1 / prod_{j != i} (x_i - x_j)
+ */
+template <typename T, std::size_t N>
+constexpr std::array<T, N> fixed_barycentric_weights(const std::array<T, N>& nodes)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...> indices) {
+        return std::array<T, N>{fixed_barycentric_weight<T, N, I>(nodes, indices)...};
+    }(std::make_index_sequence<N>{});
+}
+
+/**
+ * @brief Storage, fit & queries shared by the fixed-size interpolators, the evaluation of the fitted
+ * polynomial being provided by Derived::_evaluate (static dispatch)
+ *
+ * @tparam Derived concrete interpolator
+ * @tparam T floating point type
+ * @tparam N number of nodes
+ */
+template <typename Derived, typename T, int N>
+class FixedInterpolator {
+    static_assert(std::is_floating_point_v<T>, "Fixed-size interpolators need a floating point type");
+    static_assert(N >= 2, "Fixed-size interpolators need at least 2 nodes");
+
+    public:
+        using Vector = Eigen::Matrix<T, N, 1>;
+
+    protected:
+        /* Nodes, values & barycentric weights */
+        Vector _nodes = Vector::Zero();
+        Vector _values = Vector::Zero();
+        Vector _weights = Vector::Zero();
+
+        /* Range of the nodes */
+        T _x_min = 0, _x_max = 0;
+
+        /* Policy applied to out-of-range queries */
+        ExtrapolationPolicy _extrapolation_policy = ExtrapolationPolicy::THROW;
+
+        /* prod_{j != I} (x - x_j), unrolled */
+        template <int I, int... J>
+        static T _product_except(const Vector& nodes, T x, std::integer_sequence<int, J...>)
+        {
+            return ((J == I ? T(1) : x - nodes(J)) * ...);
+        }
+
+        /* Sets the nodes, their range & their weights */
+        void _set_nodes(const Vector& nodes, const Vector& weights)
+        {
+            this->_nodes = nodes;
+            this->_weights = weights;
+            this->_x_min = nodes.minCoeff();
+            this->_x_max = nodes.maxCoeff();
+        }
+
+    public:
+        FixedInterpolator() = default;
+
+        /**
+         * @brief Construct an interpolator on nodes whose weights were computed beforehand
+         * (e.g. by fixed_barycentric_weights() at compile time), the values being set by set_values()
+         *
+         * @param nodes distinct nodes
+         * @param weights barycentric weights of the nodes
+         */
+        FixedInterpolator(const std::array<T, N>& nodes, const std::array<T, N>& weights)
+        {
+            this->_set_nodes(Eigen::Map<const Vector>(nodes.data()), Eigen::Map<const Vector>(weights.data()));
+        }
+
+        /**
+         * @brief Fits the interpolant through (nodes, values), the weights being computed with unrolled loops
+         *
+         * @param nodes distinct nodes
+         * @param values values at the nodes
+         */
+        void fit(const Vector& nodes, const Vector& values)
+        {
+            INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
+            Vector weights;
+            [&]<int... I>(std::integer_sequence<int, I...> indices) {
+                ((weights(I) = _product_except<I>(nodes, nodes(I), indices)), ...);
+            }(std::make_integer_sequence<int, N>{});
+            if ((weights.array() == 0).any())
+            {
+                throw InterpolationProjectException::DivisionByZero("Two datapoints have the same value for weight calculation!", __func__);
+            }
+            this->_set_nodes(nodes, weights.cwiseInverse());
+            this->_values = values;
+        }
+
+        /**
+         * @brief Replaces the values at the (unchanged) nodes, refitting in O(N)
+         *
+         * @param values values at the nodes
+         */
+        void set_values(const Vector& values) { this->_values = values; }
+
+        /**
+         * @brief Evaluates the interpolant at x, out-of-range queries following the extrapolation policy
+         *
+         * @param x query
+         * @return T interpolated value
+         */
+        T operator()(T x) const
+        {
+            INTERPOLATION_STATS_ADD(QUERIES, 1);
+            if (x < this->_x_min || x > this->_x_max)
+            {
+                INTERPOLATION_STATS_ADD(EXTRAPOLATIONS, 1);
+                switch (this->_extrapolation_policy)
+                {
+                    case ExtrapolationPolicy::CLAMP:
+                        x = std::clamp(x, this->_x_min, this->_x_max);
+                        break;
+                    case ExtrapolationPolicy::NAN_VALUE:
+                        return std::numeric_limits<T>::quiet_NaN();
+                    case ExtrapolationPolicy::EXTRAPOLATE:
+                        break;
+                    case ExtrapolationPolicy::THROW:
+                    default:
+                        INTERPOLATION_STATS_ADD(EXTRAPOLATION_ERRORS, 1);
+                        throw InterpolationProjectException::Extrapolation(x, this->_x_min, this->_x_max, __func__);
+                }
+            }
+            return static_cast<const Derived*>(this)->_evaluate(x);
+        }
+
+        /**
+         * @brief Evaluates the interpolant at a batch of queries
+         *
+         * @param X M x 1 queries
+         * @return Eigen::VectorX<T> interpolated values
+         */
+        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) const
+        {
+            if (X.cols() > 1)
+            {
+                throw InterpolationProjectException::MultidimensionalImplementation("Fixed-size interpolators are 1D only!", __func__);
+            }
+            Eigen::VectorX<T> y(X.rows());
+            for (Eigen::Index i = 0; i < X.rows(); i++)
+            {
+                y(i) = (*this)(X(i, 0));
+            }
+            return y;
+        }
+
+        void set_extrapolation_policy(ExtrapolationPolicy policy) { this->_extrapolation_policy = policy; }
+
+        ExtrapolationPolicy get_extrapolation_policy() const { return this->_extrapolation_policy; }
+
+        const Vector& get_nodes() const { return this->_nodes; }
+
+        const Vector& get_values() const { return this->_values; }
+
+        const Vector& get_weights() const { return this->_weights; }
+
+        std::pair<T, T> get_range() const { return std::make_pair(this->_x_min, this->_x_max); }
+};
+
+/**
+ * @brief Barycentric interpolation (second form) through N nodes, O(N) per query with vectorized divisions
+ *
+ * @tparam T floating point type
+ * @tparam N number of nodes
+ */
+template <typename T, int N>
+class FixedBarycentricInterpolator: public FixedInterpolator<FixedBarycentricInterpolator<T, N>, T, N> {
+    friend class FixedInterpolator<FixedBarycentricInterpolator<T, N>, T, N>;
+    using Base = FixedInterpolator<FixedBarycentricInterpolator<T, N>, T, N>;
+
+    protected:
+        /* Barycentric formula on fixed-size arrays (vectorized divisions), the exact nodes returning their value */
+        T _evaluate(T x) const
+        {
+            const Eigen::Array<T, N, 1> d = x - this->_nodes.array();
+            if ((d == 0).any())
+            {
+                return this->_values(std::find(d.data(), d.data() + N, T(0)) - d.data());
+            }
+            const Eigen::Array<T, N, 1> t = this->_weights.array() / d;
+            return (t * this->_values.array()).sum() / t.sum();
+        }
+
+    public:
+        using Base::Base;
+};
+
+/**
+ * @brief Lagrange interpolation through N nodes in the division-free form
+ * p(x) = sum_i w_i y_i prod_{j != i} (x - x_j), N^2 independent multiplications per query: faster
+ * than the barycentric formula up to about 8 nodes and without any special case at the nodes, but
+ * without the cancellation of the rounding errors of the weights by the barycentric denominator
+ *
+ * @tparam T floating point type
+ * @tparam N number of nodes
+ */
+template <typename T, int N>
+class FixedLagrangeInterpolator: public FixedInterpolator<FixedLagrangeInterpolator<T, N>, T, N> {
+    friend class FixedInterpolator<FixedLagrangeInterpolator<T, N>, T, N>;
+    using Base = FixedInterpolator<FixedLagrangeInterpolator<T, N>, T, N>;
+
+    protected:
+        /* Unrolled sum of the Lagrange basis polynomials */
+        T _evaluate(T x) const
+        {
+            return [&]<int... I>(std::integer_sequence<int, I...> indices) {
+                return ((this->_weights(I) * this->_values(I) * Base::template _product_except<I>(this->_nodes, x, indices)) + ...);
+            }(std::make_integer_sequence<int, N>{});
+        }
+
+    public:
+        using Base::Base;
+};
@@ -2,18 +2,276 @@
 
 #include <unsupported/Eigen/FFT>
 #include <Eigen/Core>
+#include <vector>
+#include "interpolator.hpp"
 #include "project_exceptions.hpp"
 
+/* Default accuracy (relative to the signal magnitude) of the evaluation at arbitrary points */
+#define NUFFT_DEFAULT_TOLERANCE 1e-10
+
+/* Oversampling factor of the spreading grid */
+#define NUFFT_OVERSAMPLING 2
+
+/* Largest half-width (in grid points) of the Gaussian spreading kernel */
+#define NUFFT_MAX_SPREAD 16
+
+/* Minimum number of streamed samples between two exact recomputations of the spectrum (at least N) */
+#define SLIDING_DFT_RENORMALIZATION 4096
+
+/**
+ * @brief Trigonometric approximation of a periodic signal sampled at N equispaced points.
+ *
+ * The samples v_j are taken at x_j = x_min + j (x_max - x_min) / N over one period [x_min, x_max).
+ * Only the N/2+1 non-negative frequencies of the real-to-complex transform are stored, and the
+ * FFT object (with its cached plans & twiddles) is kept across fit() and approximate_points()
+ * calls, so repeated calls with the same sizes do not plan the transforms again.
+ *
+ * Arbitrary points are evaluated with a type-2 non-uniform FFT: fit() deconvolves the spectrum by
+ * a Gaussian kernel and transforms it once onto a 2N points grid, each query then only sums the
+ * 2 x spread grid values around it weighted by the Gaussian (fast Gaussian gridding, 2 exponentials
+ * per query). Evaluating M points thus costs O(N log N + M spread) instead of the O(N M) of the
+ * direct trigonometric sums, the spread being chosen from the tolerance (about 1 digit per point).
+ * Queries outside of the period follow the extrapolation policy, EXTRAPOLATE evaluating the
+ * periodic extension.
+ *
+ * In streaming mode, push() slides the window by one sample and updates the spectrum with the
+ * sliding DFT recurrence X_k <- (X_k + x_new - x_old) e^{2 i pi k / N}, in O(N) or in O(K) when only
+ * K bins are tracked (see track_bins()), the period moving forward by one step. The spectrum is
+ * recomputed exactly every max(N, SLIDING_DFT_RENORMALIZATION) samples to bound the rounding drift
+ * of the recurrence. synthesize() evaluates the tracked bins directly at the requested points, while
+ * operator() rebuilds its NUFFT grid (O(N log N)) on the first query after new samples.
+ *
+ * @tparam T signal type (float, double, long double)
+ */
 template <typename T>
-class FourierApproximator {
+class FourierApproximator: public Interpolator<T> {
+
+    protected:
+        /* Half spectrum (N/2+1 bins, unnormalized) of the fitted signal */
+        Eigen::VectorX<std::complex<T>> _freq;
+
+        /* Real FFT, reused for its cached plans */
+        Eigen::FFT<T> _fft;
+
+        /* Number of fitted samples */
+        Eigen::Index _n = 0;
+
+        /* Period [x_min, x_max) of the fitted signal */
+        T _x_min = 0, _x_max = 0;
+
+        /* Spectrum buffers of the resampling (reused between calls) */
+        Eigen::VectorX<std::complex<T>> _spectrum;
+        Eigen::VectorX<std::complex<T>> _resampled;
+
+        /* Requested accuracy, half-width (grid points) & variance parameter of the Gaussian kernel */
+        T _tolerance;
+        int _spread = 0;
+        T _tau = 0;
+
+        /* Deconvolved signal on the oversampled grid (scaled by the grid size) */
+        Eigen::VectorX<T> _grid;
+
+        /* exp(-(j h)^2 / 4 tau) for j = 0 .. spread, h being the grid step */
+        Eigen::VectorX<T> _kernel;
+
+        /* The grid does not match the spectrum anymore (samples were pushed) */
+        bool _grid_stale = false;
+
+        /* Streaming window (ring buffer, _head being its oldest sample) */
+        Eigen::VectorX<T> _window;
+        Eigen::Index _head = 0;
+
+        /* Updated bins & their sliding DFT twiddles e^{2 i pi k / N} */
+        std::vector<Eigen::Index> _bins;
+        Eigen::VectorX<std::complex<T>> _twiddles;
+
+        /* Start of the fitted period, sampling step, number of samples pushed since the fit & since the last renormalization */
+        T _x_origin = 0;
+        T _step = 0;
+        Eigen::Index _pushed = 0;
+        Eigen::Index _since_renormalization = 0;
+
+        /**
+         * @brief Computes the kernel parameters & the deconvolved grid of the fitted spectrum
+         */
+        void _prepare_grid();
+
+        /**
+         * @brief Evaluates the interpolant at x (wrapped into the period) from the grid
+         */
+        T _evaluate(T x) const;
+
+        /**
+         * @brief Evaluates the interpolant at x (wrapped into the period) by direct sums over the tracked bins
+         */
+        T _evaluate_direct(T x) const;
+
+        /**
+         * @brief Evaluates the query x according to the extrapolation policy, from the grid or by direct sums
+         */
+        T _query(T x, const char* where, bool direct) const;
 
-    Eigen::VectorX<std::complex<T>> _freq;
-    Eigen::FFT<T> _fft;
-    T _x_min, _x_max;
+        /**
+         * @brief Maps the half spectrum of N samples to the (normalized) half spectrum of n samples
+         * of the same trigonometric interpolant: truncated or zero padded, with the Nyquist bins
+         * split or folded so that the resampled values remain real & consistent
+         *
+         * @param freq half spectrum (N/2+1 bins)
+         * @param N number of samples of freq
+         * @param n number of resampled points
+         * @param out half spectrum (n/2+1 bins) to invert without scaling
+         */
+        static void _resample_spectrum(const Eigen::VectorX<std::complex<T>>& freq, Eigen::Index N, Eigen::Index n,
+                                       Eigen::VectorX<std::complex<T>>& out);
 
     public:
-        FourierApproximator();
+        /**
+         * @brief Construct a new Fourier Approximator object
+         *
+         * @param tolerance accuracy of the evaluation at arbitrary points (at least 10 machine epsilons)
+         */
+        explicit FourierApproximator(T tolerance = T(NUFFT_DEFAULT_TOLERANCE));
+
+        /**
+         * @brief Fits the interpolant on equispaced datapoints (the period ends one step after the last one)
+         *
+         * @param X N x 2 datapoints, sorted by their sample position
+         * @param dim_idx the column idx of the signal values
+         */
+        void fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx) override;
+
+        /**
+         * @brief Fits the interpolant on equispaced datapoints (the period ends one step after the last one)
+         *
+         * @param X N x 1 ascending & equispaced sample positions
+         * @param y N signal values
+         */
+        void fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) override;
+
+        /**
+         * @brief Computes the spectrum of N equispaced samples over the period [0, N)
+         *
+         * @param v signal samples
+         */
         void fit(const Eigen::VectorX<T>& v);
+
+        /**
+         * @brief Computes the spectrum of N equispaced samples over the period [x_min, x_max)
+         *
+         * @param v signal samples
+         * @param x_min position of the first sample
+         * @param x_max end of the period (position of the N+1-th sample)
+         */
+        void fit(const Eigen::VectorX<T>& v, T x_min, T x_max);
+
+        /**
+         * @brief Evaluates the fitted interpolant at n equispaced points of the period (see sample_points())
+         *
+         * @param n number of points
+         * @return Eigen::VectorX<T> resampled signal
+         */
         Eigen::VectorX<T> approximate_points(int n);
 
-};
\ No newline at end of file
+        /**
+         * @brief Get the positions of n equispaced points over the fitted period, x_i = x_min + i (x_max - x_min) / n
+         *
+         * @param n number of points
+         * @return Eigen::VectorX<T> positions
+         */
+        Eigen::VectorX<T> sample_points(int n) const;
+
+        /**
+         * @brief Evaluates the fitted interpolant at n equispaced points of the period
+         *
+         * @param n number of points
+         * @return Eigen::MatrixX<T> n x 2 matrix of (x, y) rows mapped onto the fitted period
+         */
+        Eigen::MatrixX<T> approximate(int n);
+
+        /**
+         * @brief Evaluates the interpolant at arbitrary points in O(N log N + M) (the N log N part being done by fit)
+         *
+         * @param X M x 1 query positions
+         * @return Eigen::VectorX<T> interpolated values
+         */
+        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) final;
+
+        /**
+         * @brief Evaluates the interpolant at an arbitrary point
+         *
+         * @param x query position
+         * @return T interpolated value
+         */
+        T operator()(T x) final;
+
+        /**
+         * @brief Resamples many equal-length signals at once with the same transform plans, without
+         * changing the fitted spectrum
+         *
+         * @param signals N x K matrix of K signals of N equispaced samples
+         * @param n number of output points
+         * @return Eigen::MatrixX<T> n x K resampled signals
+         */
+        Eigen::MatrixX<T> resample(const Eigen::MatrixX<T>& signals, int n);
+
+        /**
+         * @brief Slides the window by one sample (streaming mode), the oldest sample being dropped
+         *
+         * @param sample new sample, one step after the end of the current period
+         */
+        void push(T sample);
+
+        /**
+         * @brief Slides the window by the given samples, in order
+         *
+         * @param samples new samples
+         */
+        void push(const Eigen::VectorX<T>& samples);
+
+        /**
+         * @brief Restricts the spectrum to the given bins (the others are zeroed and not updated anymore
+         * by push()), or tracks all the bins again if empty. fit() tracks all the bins.
+         *
+         * @param bins frequencies in [0, N/2]
+         */
+        void track_bins(const std::vector<Eigen::Index>& bins);
+
+        /**
+         * @brief Recomputes the tracked bins exactly from the current window (FFT or direct DFT)
+         */
+        void renormalize();
+
+        /**
+         * @brief Evaluates the tracked bins directly at the requested points in O(K) per point,
+         * without rebuilding the NUFFT grid
+         *
+         * @param X M x 1 query positions
+         * @return Eigen::VectorX<T> interpolated values
+         */
+        Eigen::VectorX<T> synthesize(const Eigen::MatrixX<T>& X) const;
+
+        /**
+         * @brief Get the half spectrum (N/2+1 bins) of the fitted signal
+         */
+        const Eigen::VectorX<std::complex<T>>& get_spectrum() const { return this->_freq; }
+
+        /**
+         * @brief Get the number of fitted samples
+         */
+        Eigen::Index size() const { return this->_n; }
+
+        /**
+         * @brief Get the tracked bins
+         */
+        const std::vector<Eigen::Index>& get_bins() const { return this->_bins; }
+
+        /**
+         * @brief Get the fitted period [x_min, x_max) (moving forward with the pushed samples)
+         */
+        std::pair<T, T> get_range() const { return std::make_pair(this->_x_min, this->_x_max); }
+
+        /**
+         * @brief Get the half-width (in grid points) of the spreading kernel
+         */
+        int get_spread() const { return this->_spread; }
+};
@@ -0,0 +1,130 @@
+/**
+ * @file instrumentation.hpp
+ * @brief Optional hot-path counters of the interpolators & data reader (compiled with INTERPOLATION_STATS)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Copy of the counters at a point in time
+ *
+ */
+struct StatsSnapshot {
+    /* Completed fits & their total duration */
+    std::uint64_t fits = 0;
+    std::uint64_t fit_ns = 0;
+    /* Batch evaluations & the number of points they contained */
+    std::uint64_t batches = 0;
+    std::uint64_t batch_queries = 0;
+    /* Evaluated points (batch & scalar queries) */
+    std::uint64_t queries = 0;
+    /* Queries outside of the fitted range & those that threw */
+    std::uint64_t extrapolations = 0;
+    std::uint64_t extrapolation_errors = 0;
+    /* Barycentric queries falling exactly on a node */
+    std::uint64_t exact_node_hits = 0;
+    /* Cubic spline bin searches & the bins walked from the initial guess */
+    std::uint64_t bin_searches = 0;
+    std::uint64_t bin_walk_steps = 0;
+    /* DataReader parsed files, bytes & duration */
+    std::uint64_t files_read = 0;
+    std::uint64_t bytes_read = 0;
+    std::uint64_t read_ns = 0;
+
+    /**
+     * @brief Human readable dump of the counters and the derived rates
+     */
+    std::string to_string() const;
+};
+
+/**
+ * @brief Process-wide counters. Updates are relaxed atomic additions made through the
+ * INTERPOLATION_STATS_* macros, which compile to nothing unless INTERPOLATION_STATS is defined.
+ *
+ */
+class Stats {
+
+    public:
+        enum Counter {
+            FITS, FIT_NS, BATCHES, BATCH_QUERIES, QUERIES, EXTRAPOLATIONS, EXTRAPOLATION_ERRORS,
+            EXACT_NODE_HITS, BIN_SEARCHES, BIN_WALK_STEPS, FILES_READ, BYTES_READ, READ_NS, COUNTERS
+        };
+
+        /**
+         * @brief True if the counters are compiled in
+         */
+        static constexpr bool enabled()
+        {
+#ifdef INTERPOLATION_STATS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Adds value to a counter
+         */
+        static void add(Counter counter, std::uint64_t value)
+        {
+            _counters[counter].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Reads all the counters (each one atomically, not the whole set)
+         */
+        static StatsSnapshot snapshot();
+
+        /**
+         * @brief Sets all the counters back to 0
+         */
+        static void reset();
+
+    private:
+        inline static std::atomic<std::uint64_t> _counters[COUNTERS] = {};
+};
+
+/**
+ * @brief Adds the lifetime of the scope to a duration counter (and 1 to a count counter). Nested
+ * scopes of the same thread (e.g. a fit calling the fit of its base class) are only counted once.
+ *
+ */
+class StatsScope {
+
+    private:
+        Stats::Counter _count;
+        Stats::Counter _duration;
+        std::chrono::steady_clock::time_point _start;
+        inline static thread_local int _depth = 0;
+
+    public:
+        StatsScope(Stats::Counter count, Stats::Counter duration)
+            : _count(count), _duration(duration), _start(std::chrono::steady_clock::now())
+        {
+            _depth++;
+        }
+
+        ~StatsScope()
+        {
+            if (--_depth > 0) { return; }
+            Stats::add(this->_count, 1);
+            Stats::add(this->_duration, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->_start).count());
+        }
+};
+
+#ifdef INTERPOLATION_STATS
+#define INTERPOLATION_STATS_ADD(counter, value) Stats::add(Stats::counter, (value))
+#define INTERPOLATION_STATS_SCOPE(count, duration) StatsScope _stats_scope(Stats::count, Stats::duration)
+#else
+#define INTERPOLATION_STATS_ADD(counter, value) ((void)0)
+#define INTERPOLATION_STATS_SCOPE(count, duration) ((void)0)
+#endif
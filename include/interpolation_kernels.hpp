@@ -0,0 +1,223 @@
+/**
+ * @file interpolation_kernels.hpp
+ * @brief Evaluation kernels shared by the fitted interpolators and the memory mapped models
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The kernels only take raw arrays, so they evaluate Eigen storage and file mappings alike. The
+ * barycentric & spline kernels read their arrays as S and compute in T, so that narrower storage
+ * (e.g. float models evaluated in double) only costs a conversion per load.
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "instrumentation.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Lagrange polynomial through (nodes[i], values[i]) evaluated at x
+ * \f[
+ *      p(x) = \sum_i y_i \prod_{j \neq i} \frac{x-x_j}{x_i-x_j}
+ * \f]
+ */
+template <typename T>
+inline T lagrange_kernel(T x, const T* nodes, const T* values, Eigen::Index n)
+{
+    T y = 0;
+    for (Eigen::Index i = 0; i < n; i++)
+    {
+        T li = 1;
+        for (Eigen::Index j = 0; j < n; j++)
+        {
+            if (j == i) { continue; }
+            // Checking for division by 0
+            if (nodes[i] - nodes[j] == 0) { throw LagrangeInterpolatorException::DivisionByZero(); }
+            li *= (x - nodes[j]) / (nodes[i] - nodes[j]);
+        }
+        y += li * values[i];
+    }
+    return y;
+}
+
+/**
+ * @brief Barycentric formula (second form) with the given weights evaluated at x
+ */
+template <typename T, typename S = T>
+inline T barycentric_kernel(T x, const S* nodes, const S* values, const S* weights, Eigen::Index n)
+{
+    T weighted_sum = 0, sum = 0;
+    for (Eigen::Index j = 0; j < n; j++)
+    {
+        const T d = x - T(nodes[j]);
+        // Check if the querry point is an exact point
+        if (d == 0)
+        {
+            INTERPOLATION_STATS_ADD(EXACT_NODE_HITS, 1);
+            return T(values[j]);
+        }
+        const T intermediate = T(weights[j]) / d;
+        sum += intermediate;
+        weighted_sum += intermediate * T(values[j]);
+    }
+    return weighted_sum / sum;
+}
+
+/**
+ * @brief Error-free sum (Knuth's TwoSum): a + b = s + error exactly
+ */
+template <typename T>
+inline T two_sum(T a, T b, T& error)
+{
+    const T s = a + b;
+    const T bb = s - a;
+    error = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+/**
+ * @brief Error-free product (TwoProd): a * b = p + error exactly. Uses the FMA when it is
+ * implemented in hardware, Dekker's product with Veltkamp's splitting otherwise.
+ */
+template <typename T>
+inline T two_prod(T a, T b, T& error)
+{
+    const T p = a * b;
+#ifdef FP_FAST_FMA
+    error = std::fma(a, b, -p);
+#else
+    constexpr T split = T((1ull << ((std::numeric_limits<T>::digits + 1) / 2)) + 1);
+    const T ca = split * a, cb = split * b;
+    const T a_hi = ca - (ca - a), b_hi = cb - (cb - b);
+    const T a_lo = a - a_hi, b_lo = b - b_hi;
+    error = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+    return p;
+}
+
+/**
+ * @brief Barycentric formula evaluated with compensated sums: the differences x - x_j, the divisions
+ * by them, the products by the values and both sums carry their rounding errors (TwoSum, TwoProd &
+ * the division residual), so that the result is about as accurate as with twice the working precision
+ * (e.g. long double accuracy in double, without x87 arithmetic). Integral types use barycentric_kernel.
+ */
+template <typename T, typename S = T>
+inline T barycentric_kernel_compensated(T x, const S* nodes, const S* values, const S* weights, Eigen::Index n)
+{
+    if constexpr (!std::is_floating_point_v<T>)
+    {
+        return barycentric_kernel(x, nodes, values, weights, n);
+    }
+    else
+    {
+        T num = 0, num_error = 0, den = 0, den_error = 0;
+        for (Eigen::Index j = 0; j < n; j++)
+        {
+            T d_error;
+            const T d = two_sum(x, -T(nodes[j]), d_error);
+            if (d == 0)
+            {
+                INTERPOLATION_STATS_ADD(EXACT_NODE_HITS, 1);
+                return T(values[j]);
+            }
+            // w / (d + d_error) = t + t_error up to second order terms, w - t d being exact
+            T r_error;
+            const T w = T(weights[j]), y = T(values[j]);
+            const T t = w / d;
+            const T r = two_prod(t, d, r_error);
+            const T t_error = ((w - r) - r_error - t * d_error) / d;
+
+            T e;
+            den = two_sum(den, t, e);
+            den_error += e + t_error;
+
+            T p_error;
+            const T p = two_prod(t, y, p_error);
+            num = two_sum(num, p, e);
+            num_error += e + p_error + t_error * y;
+        }
+        // Corrected quotient of the compensated sums
+        T q_error;
+        const T q = num / den;
+        const T r = two_prod(q, den, q_error);
+        return q + (((num - r) - q_error) + num_error - q * den_error) / den;
+    }
+}
+
+/**
+ * @brief Index of the spline segment [knots[i], knots[i+1]) containing x (first/last segment outside of the range).
+ * Starts from the guess of evenly spaced knots and walks to the right segment.
+ */
+template <typename T, typename S = T>
+inline Eigen::Index spline_segment(T x, const S* knots, Eigen::Index n, T x_min, T x_max)
+{
+    Eigen::Index idx = (Eigen::Index) ((std::clamp(x, x_min, x_max) - x_min) / (x_max - x_min) * (n - 1));
+    idx = std::clamp<Eigen::Index>(idx, 0, n - 2);
+#ifdef INTERPOLATION_STATS
+    const Eigen::Index guess = idx;
+#endif
+    while (idx > 0 && x < knots[idx]) {
+        idx--;
+    }
+    while (idx < n - 2 && x >= knots[idx + 1]) {
+        idx++;
+    }
+    INTERPOLATION_STATS_ADD(BIN_SEARCHES, 1);
+    INTERPOLATION_STATS_ADD(BIN_WALK_STEPS, std::abs(idx - guess));
+    return idx;
+}
+
+/**
+ * @brief Cubic spline evaluated at x
+ *
+ * @param knots n sorted knots
+ * @param coefficients column-major (n-1) x 4 matrix of the segments coefficients (a, b, c, d)
+ */
+template <typename T, typename S = T>
+inline T spline_kernel(T x, const S* knots, const S* coefficients, Eigen::Index n, T x_min, T x_max)
+{
+    const Eigen::Index segments = n - 1;
+    const Eigen::Index i = spline_segment(x, knots, n, x_min, x_max);
+    const T dx = x - T(knots[i]);
+    return T(coefficients[i]) + T(coefficients[segments + i])*dx + T(coefficients[2*segments + i])*dx*dx + T(coefficients[3*segments + i])*dx*dx*dx;
+}
+
+/**
+ * @brief Cubic spline evaluated at x with the compensated Horner scheme (TwoProd & TwoSum at each step,
+ * the rounding error of x - knot being propagated through the derivative), about as accurate as with
+ * twice the working precision. Integral types use spline_kernel.
+ *
+ * @param knots n sorted knots
+ * @param coefficients column-major (n-1) x 4 matrix of the segments coefficients (a, b, c, d)
+ */
+template <typename T, typename S = T>
+inline T spline_kernel_compensated(T x, const S* knots, const S* coefficients, Eigen::Index n, T x_min, T x_max)
+{
+    if constexpr (!std::is_floating_point_v<T>)
+    {
+        return spline_kernel(x, knots, coefficients, n, x_min, x_max);
+    }
+    else
+    {
+        const Eigen::Index segments = n - 1;
+        const Eigen::Index i = spline_segment(x, knots, n, x_min, x_max);
+        T dx_error;
+        const T dx = two_sum(x, -T(knots[i]), dx_error);
+        const T a = T(coefficients[i]), b = T(coefficients[segments + i]), c = T(coefficients[2*segments + i]), d = T(coefficients[3*segments + i]);
+
+        // Horner steps s <- s dx + coefficient, with their errors accumulated by Horner as well
+        T s = d, error = 0, p_error, s_error;
+        for (const T coefficient : {c, b, a})
+        {
+            const T p = two_prod(s, dx, p_error);
+            s = two_sum(p, coefficient, s_error);
+            error = error * dx + (p_error + s_error);
+        }
+        return s + (error + (b + dx*(2*c + 3*d*dx)) * dx_error);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file interpolation_pipeline.hpp
+ * @brief Read -> fit -> evaluate -> write pipeline running its stages concurrently
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "interpolator.hpp"
+
+/* Number of items each stage may get ahead of the next one */
+#define PIPELINE_QUEUE_CAPACITY 2
+
+/**
+ * @brief A data file to interpolate & the files to write
+ *
+ */
+struct PipelineJob {
+    std::filesystem::path input;                    ///< Data file (text, binary or compressed)
+    std::filesystem::path data_output;              ///< Text copy of the datapoints (not written if empty)
+    std::vector<std::filesystem::path> outputs;     ///< "x y" grid file of each interpolator
+};
+
+/**
+ * @brief Time spent working (not waiting) by each stage of a run, and its wall time (seconds)
+ *
+ */
+struct PipelineTimings {
+    double read = 0.0;
+    double fit = 0.0;
+    double evaluate = 0.0;
+    double write = 0.0;
+    double wall = 0.0;
+};
+
+/**
+ * @brief Fits interpolators on data files, evaluates them on a regular grid of the data range and
+ * writes the results, with the four stages running on their own thread.
+ *
+ * The stages are connected by BoundedQueues of PIPELINE_QUEUE_CAPACITY items, so while interpolator k
+ * is evaluated, interpolator k+1 is fitted, the results of k-1 are formatted & written and the next
+ * data file is parsed, with at most a few fitted interpolators or grids in flight. The wall time
+ * of a run thus approaches the one of its slowest stage instead of the sum of all of them.
+ *
+ * The first exception thrown by a stage stops the others and is rethrown by run().
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+class InterpolationPipeline {
+
+    private:
+        /* Read-only dataset, released once the last stage holding it is done */
+        using Dataset = std::shared_ptr<const Eigen::MatrixX<T>>;
+
+        /* Dataset read from the input of job `job` */
+        struct Loaded {
+            std::size_t job;
+            Dataset data;
+        };
+
+        /* Interpolator `k` fitted on the dataset of job `job` */
+        struct Fitted {
+            std::size_t job;
+            std::size_t k;
+            Dataset data;
+            std::unique_ptr<Interpolator<T>> interpolator;
+        };
+
+        /* Datapoints to write to `path` */
+        struct Output {
+            std::filesystem::path path;
+            Dataset data;
+        };
+
+        /* Interpolation schemes & cubic spline options */
+        std::vector<std::string> _interpolators;
+        std::vector<std::string> _options;
+
+        /* Number of grid samples */
+        Eigen::Index _samples;
+
+        /* Capacity of the queues between stages */
+        std::size_t _capacity;
+
+    public:
+        /**
+         * @brief Construct a new Interpolation Pipeline object
+         *
+         * @param interpolators interpolation schemes (lagrange, barycentric, cubic_spline)
+         * @param options cubic spline options
+         * @param samples number of grid samples
+         * @param capacity number of items each stage may get ahead of the next one
+         */
+        InterpolationPipeline(const std::vector<std::string>& interpolators, const std::vector<std::string>& options,
+                              Eigen::Index samples, std::size_t capacity = PIPELINE_QUEUE_CAPACITY);
+
+        /**
+         * @brief Processes the jobs in order and waits for all their files to be written
+         *
+         * @param jobs data files & outputs (one output per interpolator)
+         * @return PipelineTimings busy time of each stage & wall time
+         */
+        PipelineTimings run(const std::vector<PipelineJob>& jobs) const;
+};
@@ -32,17 +32,14 @@ class LagrangeInterpolator: public PolynomialInterpolator<T> {
          */
         T _lagrange_basis(unsigned int i, const Eigen::VectorX<T>& x_interpolation);
 
+    protected:
         /**
-         * @brief 2D specific version of to compute lagrange basis l_i : 
+         * @brief Evaluates the lagrange polynomial at x (no range check)
          * 
-         * \f[
-         *      l_i(x) = \prod_{j,j \neq i}^{n} \frac{x-x_j}{x_i-x_j}
-         * \f]
-         * @param i Index of the basis function (refers to datapoint x_i) 
-         * @param x_interpolation 1-dimensional interpolation point x
-         * @return T Value of the i-th polynomial evaluated @x
+         * @param x 1D datapoint
+         * @return T interpolated function values @ x
          */
-        T _lagrange_basis(unsigned int i, T x_interpolation);
+        T _evaluate(T x) final;
 
     public:
         /**
@@ -50,7 +47,7 @@ class LagrangeInterpolator: public PolynomialInterpolator<T> {
          */
         LagrangeInterpolator();
 
-        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) override;
+        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) final;
 
         /**
          * @brief Interpolates a single 1D datapoint
@@ -58,7 +55,7 @@ class LagrangeInterpolator: public PolynomialInterpolator<T> {
          * @param x 1D datapoint
          * @return T interpolated function values @ x
          */
-        T operator()(T x) override;
+        T operator()(T x) final;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,290 @@
+/**
+ * @file model_io.hpp
+ * @brief Versioned binary format of fitted interpolators, memory mapped for instant loading
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include "binary_dataset.hpp"
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "lagrange_interpolator.hpp"
+
+/* Magic bytes starting every model file */
+#define MODEL_FILE_MAGIC "IPMD"
+
+/* Current version of the model file format */
+#define MODEL_FILE_VERSION 1
+
+/* Alignment (bytes) of every section of a model file within the file */
+#define MODEL_SECTION_ALIGNMENT 64
+
+/**
+ * @brief Interpolation scheme stored in a model file
+ *
+ */
+enum class ModelKind : std::uint8_t {
+    LAGRANGE = 0,
+    BARYCENTRIC = 1,
+    CUBIC_SPLINE = 2,
+};
+
+/**
+ * @brief Arrays stored in a model file, each one starting at its own aligned offset
+ *
+ */
+enum ModelSection {
+    RANGE,          ///< Fitted range (min, max)
+    NODES,          ///< N interpolation nodes
+    VALUES,         ///< N fitted values
+    EXTRA,          ///< N barycentric weights or the (N-1) x 4 column-major spline coefficients
+    CLAMPED,        ///< Spline clamped values (lower, upper)
+    MODEL_SECTIONS
+};
+
+/**
+ * @brief Header of a model file (64 bytes). Values are stored in the native byte order
+ * of the machine that saved the model; absent sections have an offset of 0.
+ *
+ */
+struct ModelFileHeader {
+    char magic[4];
+    std::uint16_t version;
+    ModelKind kind;
+    DatasetType dtype;
+    std::uint32_t element_size;
+    std::uint8_t boundary_constraint;
+    std::uint8_t extrapolation_policy;
+    std::uint8_t summation_mode;
+    std::uint8_t reserved;
+    std::uint64_t n;
+    std::uint64_t offsets[MODEL_SECTIONS];
+};
+static_assert(sizeof(ModelFileHeader) == 64, "Model file header must be 64 bytes");
+
+/**
+ * @brief Number of values stored in a section of a model file
+ *
+ * @param kind interpolation scheme of the model
+ * @param section section of the file
+ * @param n number of interpolation nodes
+ * @return std::uint64_t number of values (0 if the scheme has no such section)
+ */
+std::uint64_t model_section_count(ModelKind kind, ModelSection section, std::uint64_t n);
+
+/**
+ * @brief Read-only fitted model evaluated directly from a memory mapped model file.
+ * The arrays are never copied: the mapping stays open for the lifetime of the object and
+ * get_X_data()/get_y_data() are empty, use nodes() and values() instead.
+ *
+ * @tparam T datapoints type (float, double, long double)
+ */
+template <typename T>
+class MappedModel: public PolynomialInterpolator<T> {
+
+    protected:
+        /* Mapped file */
+        boost::iostreams::mapped_file_source _file;
+
+        /* Model header */
+        ModelFileHeader _header;
+
+        /**
+         * @brief Maps and validates the model file at the given path (the stored type must be T)
+         *
+         * @param path filepath
+         * @param kind expected interpolation scheme
+         */
+        MappedModel(const std::filesystem::path& path, ModelKind kind);
+
+        /**
+         * @brief Get a pointer to a section of the mapping
+         */
+        const T* _section(ModelSection section) const;
+
+    public:
+        /**
+         * @brief Get the interpolation scheme of the model
+         */
+        ModelKind kind() const { return this->_header.kind; }
+
+        /**
+         * @brief Get the number of interpolation nodes
+         */
+        Eigen::Index size() const { return this->_header.n; }
+
+        /**
+         * @brief Get the mapped interpolation nodes (no copy)
+         */
+        Eigen::Map<const Eigen::VectorX<T>> nodes() const;
+
+        /**
+         * @brief Get the mapped fitted values (no copy)
+         */
+        Eigen::Map<const Eigen::VectorX<T>> values() const;
+
+        /**
+         * @brief Mapped models are read-only, always throws
+         */
+        void fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx) override;
+
+        /**
+         * @brief Mapped models are read-only, always throws
+         */
+        void fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) override;
+
+        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) override;
+
+        T operator()(T x) override;
+};
+
+/**
+ * @brief Lagrange model evaluated from a model file
+ *
+ */
+template <typename T>
+class MappedLagrangeInterpolator: public MappedModel<T> {
+
+    protected:
+        T _evaluate(T x) override;
+
+    public:
+        explicit MappedLagrangeInterpolator(const std::filesystem::path& path);
+};
+
+/**
+ * @brief Barycentric model evaluated from a model file
+ *
+ */
+template <typename T>
+class MappedBarycentricInterpolator: public MappedModel<T> {
+
+    protected:
+        T _evaluate(T x) override;
+
+    public:
+        explicit MappedBarycentricInterpolator(const std::filesystem::path& path);
+
+        /**
+         * @brief Get the mapped barycentric weights (no copy)
+         */
+        Eigen::Map<const Eigen::VectorX<T>> weights() const;
+};
+
+/**
+ * @brief Cubic spline model evaluated from a model file
+ *
+ */
+template <typename T>
+class MappedCubicSplineInterpolator: public MappedModel<T> {
+
+    protected:
+        T _evaluate(T x) override;
+
+    public:
+        explicit MappedCubicSplineInterpolator(const std::filesystem::path& path);
+
+        /**
+         * @brief Get the mapped (n-1) x 4 spline coefficients (no copy)
+         */
+        Eigen::Map<const Eigen::MatrixX4<T>> coefficients() const;
+
+        /**
+         * @brief Get the boundary condition the spline was fitted with
+         */
+        typename CubicSplineInterpolator<T>::BoundaryConstraint boundary_constraint() const;
+
+        /**
+         * @brief Get the clamped values the spline was fitted with
+         */
+        Eigen::Vector2<T> clamped_values() const;
+};
+
+/**
+ * @brief Saves fitted interpolators as model files & loads them back as mapped models
+ *
+ * @tparam T datapoints type (float, double, long double)
+ */
+template <typename T>
+class ModelIO {
+
+    private:
+        /* Pointer & number of values of every section to write */
+        using Sections = std::array<std::pair<const T*, std::uint64_t>, MODEL_SECTIONS>;
+
+        /**
+         * @brief Writes the header (completed with the format fields & offsets) and the aligned sections
+         */
+        static void _write(const std::filesystem::path& path, ModelFileHeader header, const Sections& sections);
+
+        /**
+         * @brief Header & sections shared by the polynomial interpolators (range, nodes & values)
+         *
+         * @param kind interpolation scheme
+         * @param interpolator fitted 1D interpolator
+         * @param range storage for the range section
+         * @param header header to fill
+         * @return Sections the common sections
+         */
+        static Sections _polynomial_sections(ModelKind kind, const PolynomialInterpolator<T>& interpolator, std::array<T, 2>& range, ModelFileHeader& header);
+
+    public:
+        /**
+         * @brief Saves a fitted 1D Lagrange interpolator
+         *
+         * @param path filepath
+         * @param interpolator fitted interpolator
+         */
+        static void save(const std::filesystem::path& path, const LagrangeInterpolator<T>& interpolator);
+
+        /**
+         * @brief Saves a fitted 1D barycentric interpolator (nodes, values & weights)
+         *
+         * @param path filepath
+         * @param interpolator fitted interpolator
+         */
+        static void save(const std::filesystem::path& path, const BarycentricInterpolator<T>& interpolator);
+
+        /**
+         * @brief Saves a fitted cubic spline (knots, values, coefficients & boundary condition)
+         *
+         * @param path filepath
+         * @param interpolator fitted interpolator
+         */
+        static void save(const std::filesystem::path& path, const CubicSplineInterpolator<T>& interpolator);
+
+        /**
+         * @brief Saves any of the supported fitted interpolators
+         *
+         * @param path filepath
+         * @param interpolator fitted Lagrange, barycentric or cubic spline interpolator
+         */
+        static void save(const std::filesystem::path& path, const Interpolator<T>& interpolator);
+
+        /**
+         * @brief Maps a model file (the stored type must be T). The extrapolation policy
+         * saved with the model is restored.
+         *
+         * @param path filepath
+         * @return std::unique_ptr<MappedModel<T>> mapped model of the stored scheme
+         */
+        static std::unique_ptr<MappedModel<T>> load(const std::filesystem::path& path);
+
+        /**
+         * @brief Reads & validates the header of a model file
+         *
+         * @param path filepath
+         * @return ModelFileHeader the file header
+         */
+        static ModelFileHeader read_header(const std::filesystem::path& path);
+};
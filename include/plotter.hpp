@@ -45,6 +45,14 @@ public:
      * 
      */
     Plotter();
+
+    /**
+     * @brief Sends the commands to the given gnuplot command instead of the default gnuplot process,
+     * e.g. "cat > script.gp" to write a gnuplot script.
+     * 
+     * @param command shell command receiving the gnuplot commands
+     */
+    explicit Plotter(const std::string& command);
     ~Plotter();
     
     /**
@@ -12,23 +12,31 @@
 #ifndef __POLYNOMIAL_INTERPOLATOR_INCLUDE
 #define __POLYNOMIAL_INTERPOLATOR_INCLUDE
 
+#include <algorithm>
 #include "interpolator.hpp"
+#include "scratch_arena.hpp"
+
+/* Number of queries range-checked at once by the batch evaluation */
+#define EXTRAPOLATION_BLOCK_SIZE 256
 
 /**
  * @brief Class for polynomial interpolator models
  * 
  *
  * @tparam T Datatype to be used (int, float, double)
+ * @tparam S Storage type of the fitted datapoints (T by default). A narrower type (e.g. float
+ * datapoints of a double interpolator) halves the memory footprint & bandwidth of the model, the
+ * queries & sums remaining in T. The range is then widened by one ulp of S to contain the datapoints.
  */
-template <typename T> 
+template <typename T, typename S = T> 
 class PolynomialInterpolator: public Interpolator<T> {
 
     protected:
         /* Matrix of NxM datapoints */
-        Eigen::MatrixX<T> _X_data;
+        Eigen::MatrixX<S> _X_data;
 
         /* Vector of Nx1 datapoints for fitting */
-        Eigen::VectorX<T> _y_data;
+        Eigen::VectorX<S> _y_data;
 
         /* Stores the lower bound of the range */
         Eigen::VectorX<T> _X_min;
@@ -36,22 +44,66 @@ class PolynomialInterpolator: public Interpolator<T> {
         /* Stores the upper bound of the range */
         Eigen::VectorX<T> _X_max;
 
+        /* Temporaries of the fits, reset by each fit so that refits of the same size do not allocate */
+        ScratchArena _scratch;
+
         /* Calculates the interpolation interval based on fitted X */
         void _calculate_range();
 
+        /**
+         * @brief Evaluates the fitted model at the 1D point x without any range check
+         * 
+         * @param x 1D datapoint
+         * @return T interpolated value @ x
+         */
+        virtual T _evaluate(T x) = 0;
+
+        /**
+         * @brief Handles a single query lying outside of the fitted range according to the policy
+         * 
+         * @param x Out of range 1D datapoint
+         * @param policy Extrapolation policy to apply
+         * @param where Function where the query was made (used for the exception message only)
+         * @return T value returned for x by the policy
+         */
+        T _extrapolate(T x, ExtrapolationPolicy policy, const char* where);
+
+        /**
+         * @brief Evaluates a batch of 1D queries. The range is checked once per block of
+         * EXTRAPOLATION_BLOCK_SIZE queries with vectorized compares, blocks fully inside
+         * the range are evaluated without any per-point check.
+         * 
+         * @param x Queries to evaluate
+         * @param policy Extrapolation policy applied to out of range queries
+         * @param where Function where the query was made (used for the exception message only)
+         * @return Eigen::VectorX<T> interpolated values
+         */
+        Eigen::VectorX<T> _evaluate_batch(const Eigen::Ref<const Eigen::VectorX<T>>& x, ExtrapolationPolicy policy, const char* where);
+
+        /**
+         * @brief Evaluates a batch of 1D queries like _evaluate_batch(x, policy, where), the in-range
+         * queries being evaluated by the given callable. The concrete interpolators pass their kernel,
+         * selected once per batch, so that it is inlined in the loop instead of being called through
+         * the virtual _evaluate per point.
+         *
+         * @param evaluate callable T(T) evaluating one in-range query
+         */
+        template <typename Evaluate>
+        Eigen::VectorX<T> _evaluate_batch(const Eigen::Ref<const Eigen::VectorX<T>>& x, ExtrapolationPolicy policy, const char* where, Evaluate evaluate);
+
     public: 
         /**
          * @brief Getter for the X datapoints matrix 
          *
          * @return X matrix for the N datapoints of the interpolator
          */
-        const Eigen::MatrixX<T>& get_X_data() const;
+        const Eigen::MatrixX<S>& get_X_data() const;
 
         /**
          * @brief Getter for the y datapoints vector
          * @return y vector of the interpolator
          */
-        const Eigen::VectorX<T>& get_y_data() const;
+        const Eigen::VectorX<S>& get_y_data() const;
 
         /**
          * @brief Get the possible interpolation range as a pair [low,high]
@@ -70,10 +122,54 @@ class PolynomialInterpolator: public Interpolator<T> {
 
         void fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) override;
 
+        /**
+         * @brief Interpolate the given 1D datapoints using the given extrapolation policy
+         * for this call only (the interpolator policy is left untouched)
+         * 
+         * @param X Datapoints to interpolate (N x 1)
+         * @param policy Extrapolation policy for out of range datapoints
+         * @return Eigen::VectorX<T> Interpolated points
+         */
+        Eigen::VectorX<T> evaluate(const Eigen::MatrixX<T>& X, ExtrapolationPolicy policy);
+
         virtual Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) = 0;
 
         virtual T operator()(T x) = 0;
 
 };
 
+template <typename T, typename S>
+template <typename Evaluate>
+Eigen::VectorX<T> PolynomialInterpolator<T, S>::_evaluate_batch(const Eigen::Ref<const Eigen::VectorX<T>>& x, ExtrapolationPolicy policy, const char* where, Evaluate evaluate)
+{
+    const T x_min = this->_X_min(0);
+    const T x_max = this->_X_max(0);
+    const Eigen::Index n = x.rows();
+    Eigen::VectorX<T> y(n);
+    INTERPOLATION_STATS_ADD(BATCHES, 1);
+    INTERPOLATION_STATS_ADD(BATCH_QUERIES, n);
+    INTERPOLATION_STATS_ADD(QUERIES, n);
+    for (Eigen::Index start=0; start<n; start+=EXTRAPOLATION_BLOCK_SIZE)
+    {
+        const Eigen::Index len = std::min<Eigen::Index>(EXTRAPOLATION_BLOCK_SIZE, n-start);
+        const auto x_block = x.segment(start, len).array();
+        // Fast path: whole block within range, no per-point check
+        if ((x_block >= x_min).all() && (x_block <= x_max).all())
+        {
+            for (Eigen::Index i=0; i<len; i++)
+            {
+                y(start+i) = evaluate(x_block(i));
+            }
+            continue;
+        }
+        // Slow path: apply the policy to the out of range points only
+        for (Eigen::Index i=0; i<len; i++)
+        {
+            const T xi = x_block(i);
+            y(start+i) = (xi < x_min || xi > x_max) ? this->_extrapolate(xi, policy, where) : evaluate(xi);
+        }
+    }
+    return y;
+}
+
 #endif
\ No newline at end of file
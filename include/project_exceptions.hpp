@@ -335,6 +335,51 @@ class DataReaderException: public InterpolationProjectException
         };
 };
 
+/**
+ * @brief Contains specific exceptions used within the DataWriter if any
+ * 
+ */
+class DataWriterException: public InterpolationProjectException
+{
+    public:
+        /**
+         * @brief Construct a new Data Writer Exception object
+         * 
+         * @param msg Exception message
+         * @param where Function where the exception was thrown
+         */
+        DataWriterException(const std::string& msg, const std::string& where)
+            : InterpolationProjectException(msg, where)
+        {};
+
+        /**
+         * @brief Construct a new Data Writer Exception object
+         * 
+         * @param msg Exception message
+         */
+        DataWriterException(const std::string& msg)
+            : InterpolationProjectException(msg, "DataWriter")
+        {};
+};
+
+/**
+ * @brief Contains specific exceptions used within the QueryServer if any
+ * 
+ */
+class QueryServerException: public InterpolationProjectException
+{
+    public:
+        /**
+         * @brief Construct a new Query Server Exception object
+         * 
+         * @param msg Exception message
+         * @param where Function where the exception was thrown
+         */
+        QueryServerException(const std::string& msg, const std::string& where)
+            : InterpolationProjectException(msg, where)
+        {};
+};
+
 /**
  * @brief Contains specific exceptions used within the CubicSplineInterpolator if any
  * 
@@ -0,0 +1,218 @@
+/**
+ * @file query_server.hpp
+ * @brief Resident evaluation server answering binary framed batch queries over file descriptors or a Unix socket
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include "interpolator.hpp"
+#include "thread_pool.hpp"
+
+/* Largest number of points of a single request (larger requests are rejected) */
+#define QUERY_SERVER_MAX_POINTS (1 << 24)
+
+/* Default budget of the request payloads a connection may have in flight (a larger request still runs alone) */
+#define QUERY_SERVER_MAX_PENDING_BYTES (std::size_t(64) << 20)
+
+/* Longest model name of a request */
+#define QUERY_SERVER_MAX_NAME 255
+
+/* Number of latency histogram buckets per power of 2 */
+#define LATENCY_BUCKETS_PER_OCTAVE 4
+
+/**
+ * @brief Operation requested by a frame
+ *
+ */
+enum class QueryOp : std::uint8_t {
+    EVALUATE = 0,   ///< Evaluate the named model at the `count` values following the name
+    STATS = 1,      ///< Get the latency summary as `count` bytes of text (no name nor values)
+};
+
+/**
+ * @brief Status of a response
+ *
+ */
+enum class QueryStatus : std::uint8_t {
+    OK = 0,                 ///< Followed by the `count` evaluated values (or bytes of text for STATS)
+    UNKNOWN_MODEL = 1,      ///< Followed by a `count` bytes error message
+    BAD_REQUEST = 2,        ///< Followed by a `count` bytes error message
+    EVALUATION_ERROR = 3,   ///< Followed by a `count` bytes error message (e.g. extrapolation)
+};
+
+/**
+ * @brief Header of a request frame, followed by `name_length` bytes of model name and `count`
+ * values of the server type. All fields are in the native byte order.
+ *
+ */
+struct QueryRequestHeader {
+    std::uint32_t id;
+    QueryOp op;
+    std::uint8_t reserved;
+    std::uint16_t name_length;
+    std::uint64_t count;
+};
+static_assert(sizeof(QueryRequestHeader) == 16, "Query request header must be 16 bytes");
+
+/**
+ * @brief Header of a response frame. Responses of concurrent requests may come back in any order,
+ * `id` is the one of the request and `latency_ns` the time spent by the server on it.
+ *
+ */
+struct QueryResponseHeader {
+    std::uint32_t id;
+    QueryStatus status;
+    std::uint8_t reserved[3];
+    std::uint64_t count;
+    std::uint64_t latency_ns;
+};
+static_assert(sizeof(QueryResponseHeader) == 24, "Query response header must be 24 bytes");
+
+/**
+ * @brief Lock-free latency histogram with LATENCY_BUCKETS_PER_OCTAVE buckets per power of 2,
+ * percentiles are reported as the upper bound of their bucket (about 19% resolution)
+ *
+ */
+class LatencyHistogram {
+
+    private:
+        static constexpr int BUCKETS = 64 * LATENCY_BUCKETS_PER_OCTAVE;
+        std::atomic<std::uint64_t> _buckets[BUCKETS] = {};
+        std::atomic<std::uint64_t> _count = 0;
+        std::atomic<std::uint64_t> _total_ns = 0;
+        std::atomic<std::uint64_t> _max_ns = 0;
+
+        static int _bucket(std::uint64_t ns);
+        static std::uint64_t _upper_bound(int bucket);
+
+    public:
+        /**
+         * @brief Records one latency
+         */
+        void record(std::uint64_t ns);
+
+        /**
+         * @brief Get the number of recorded latencies
+         */
+        std::uint64_t count() const { return this->_count.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get an upper bound of the given percentile (0 if nothing was recorded)
+         *
+         * @param p percentile in [0, 100]
+         */
+        std::uint64_t percentile(double p) const;
+
+        /**
+         * @brief Count, mean, p50, p90, p99 & max latencies as text
+         */
+        std::string to_string() const;
+};
+
+/**
+ * @brief Keeps named fitted models resident and evaluates the batched requests on a worker pool.
+ *
+ * Requests read from a connection are dispatched to the workers as soon as they are complete,
+ * so several requests of the same or of different connections are evaluated concurrently.
+ * The models must not be refitted while the server runs.
+ *
+ * @tparam T values type of the frames (float, double, long double)
+ */
+template <typename T>
+class QueryServer {
+
+    private:
+        struct Connection;
+
+        std::map<std::string, std::shared_ptr<Interpolator<T>>> _models;
+        LatencyHistogram _latency;
+        ThreadPool _pool;
+        std::size_t _max_pending_bytes;
+        std::atomic<int> _listen_fd = -1;
+        std::atomic<bool> _stopping = false;
+
+        /**
+         * @brief Reads exactly size bytes (false on end of file or error)
+         */
+        static bool _read_exact(int fd, void* data, std::size_t size);
+
+        /**
+         * @brief Writes exactly size bytes (false on error)
+         */
+        static bool _write_all(int fd, const void* data, std::size_t size);
+
+        /**
+         * @brief Writes a response frame (header & payload) under the connection write lock
+         */
+        void _respond(Connection& connection, QueryResponseHeader header, const void* payload, std::size_t size);
+
+        /**
+         * @brief Reads the frames of a connection until end of file & waits for its pending requests
+         */
+        void _serve_connection(const std::shared_ptr<Connection>& connection);
+
+        /**
+         * @brief Evaluates one request & writes its response
+         */
+        void _process(Connection& connection, const QueryRequestHeader& header, const std::string& name,
+                      const Eigen::MatrixX<T>& values, std::chrono::steady_clock::time_point start);
+
+    public:
+        /**
+         * @brief Construct a new Query Server object
+         *
+         * @param workers number of worker threads
+         * @param max_pending_bytes payload bytes each connection may have in flight before its
+         * next request is read
+         */
+        explicit QueryServer(std::size_t workers = std::thread::hardware_concurrency(),
+                             std::size_t max_pending_bytes = QUERY_SERVER_MAX_PENDING_BYTES);
+
+        /**
+         * @brief Makes a fitted model available under the given name
+         *
+         * @param name model name used by the requests
+         * @param model fitted model
+         */
+        void add_model(const std::string& name, std::shared_ptr<Interpolator<T>> model);
+
+        /**
+         * @brief Serves the requests read from in_fd (e.g. stdin) and writes the responses to out_fd
+         * (e.g. stdout) until end of file. Returns once all the responses are written.
+         *
+         * @param in_fd file descriptor to read the requests from
+         * @param out_fd file descriptor to write the responses to
+         */
+        void serve(int in_fd, int out_fd);
+
+        /**
+         * @brief Listens on a Unix domain socket and serves every client connection until stop()
+         *
+         * @param path socket path (replaced if it already exists)
+         */
+        void serve_socket(const std::filesystem::path& path);
+
+        /**
+         * @brief Stops accepting connections and makes serve_socket return once the open
+         * connections are drained (a stopped server does not serve sockets anymore).
+         * Only uses async-signal-safe calls, so it may be called from a signal handler.
+         */
+        void stop();
+
+        /**
+         * @brief Get the per-request latencies recorded so far
+         */
+        const LatencyHistogram& latency() const { return this->_latency; }
+};
@@ -0,0 +1,105 @@
+/**
+ * @file random_generator.hpp
+ * @brief Counter-based (Philox4x32-10) random generator for reproducible parallel data generation
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <array>
+#include <cstdint>
+
+/* Default seed of the generated data */
+#define DEFAULT_RANDOM_SEED 0x5eed
+
+/* Minimum number of rows filled by each thread (smaller matrices are filled by fewer threads) */
+#define MIN_RANDOM_ROWS_PER_THREAD 4096
+
+/**
+ * @brief Philox4x32-10 block function (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+ *
+ * Maps a 128-bit counter and a 64-bit key to 128 random bits. There is no state: the i-th
+ * random number is obtained from counter i directly, so any subset of a sequence can be
+ * generated independently and in any order.
+ */
+struct Philox4x32 {
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    static constexpr std::uint32_t M0 = 0xD2511F53;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57;
+    static constexpr std::uint32_t W0 = 0x9E3779B9;
+    static constexpr std::uint32_t W1 = 0xBB67AE85;
+    static constexpr int ROUNDS = 10;
+
+    /**
+     * @brief Computes the random block of the given counter & key
+     *
+     * @param counter 128-bit counter
+     * @param key 64-bit key (seed)
+     * @return Counter 4 random 32-bit words
+     */
+    static constexpr Counter generate(Counter counter, Key key)
+    {
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            if (round > 0) { key[0] += W0; key[1] += W1; }
+            const std::uint64_t product0 = static_cast<std::uint64_t>(M0) * counter[0];
+            const std::uint64_t product1 = static_cast<std::uint64_t>(M1) * counter[2];
+            counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(product1),
+                       static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(product0)};
+        }
+        return counter;
+    }
+};
+
+/**
+ * @brief Uniform random generator where the value of the entry (row, col) only depends on the
+ * seed and its position. Matrices can therefore be filled by chunks of rows and by any number
+ * of threads while staying bit-identical.
+ *
+ * @tparam T datapoints type (int, float, double, long double)
+ */
+template <typename T>
+class RandomGenerator {
+
+    private:
+        /* Philox key */
+        Philox4x32::Key _key;
+
+    public:
+        /**
+         * @brief Construct a new Random Generator object
+         *
+         * @param seed seed of the generated values
+         */
+        explicit RandomGenerator(std::uint64_t seed = DEFAULT_RANDOM_SEED)
+            : _key({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)})
+        {};
+
+        /**
+         * @brief Uniform value of the entry (row, col), in [low, high) for floating types & [low, high] for int
+         *
+         * @param row global row index
+         * @param col column index
+         * @param low lower bound
+         * @param high upper bound
+         * @return T random value
+         */
+        T uniform(std::uint64_t row, std::uint64_t col, T low, T high) const;
+
+        /**
+         * @brief Fills data with uniform values, data(i,j) being the entry (first_row+i, j)
+         *
+         * @param data matrix (or vector) to be filled, keeps its size
+         * @param low lower bound
+         * @param high upper bound
+         * @param first_row global index of the first row of data
+         * @param threads maximum number of threads filling contiguous row ranges
+         */
+        void fill(Eigen::Ref<Eigen::MatrixX<T>> data, T low, T high, std::uint64_t first_row = 0, unsigned int threads = 1) const;
+};
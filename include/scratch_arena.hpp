@@ -0,0 +1,137 @@
+/**
+ * @file scratch_arena.hpp
+ * @brief Per-model bump allocator of the fit-time temporaries
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/* Alignment of the arrays handed out by the arena (cache line, at least Eigen's maximum alignment) */
+#define SCRATCH_ARENA_ALIGNMENT 64
+
+/* Size of the first block of an arena */
+#define SCRATCH_ARENA_MIN_BLOCK 4096
+
+static_assert(SCRATCH_ARENA_ALIGNMENT >= EIGEN_MAX_ALIGN_BYTES, "Scratch arrays must satisfy Eigen's alignment");
+
+/**
+ * @brief Scratch memory of the fits: the arrays are carved out of large blocks by bumping an offset
+ * and are all released at once by reset(), at the start of the next fit. When a fit needs more than
+ * the current block, a new block is chained and reset() merges the blocks into a single one, so that
+ * refitting models of the same (or a smaller) size does not allocate anymore.
+ *
+ * The arrays are uninitialized, hold trivially destructible types only and are valid until the next
+ * reset(). Copying an interpolator does not copy its scratch memory (the copy starts empty).
+ */
+class ScratchArena {
+
+    private:
+        struct BlockDeleter {
+            void operator()(std::byte* block) const { ::operator delete[](block, std::align_val_t(SCRATCH_ARENA_ALIGNMENT)); }
+        };
+
+        struct Block {
+            std::unique_ptr<std::byte[], BlockDeleter> data;
+            std::size_t size;
+        };
+
+        /* Blocks of the current fit, the last one being bumped */
+        std::vector<Block> _blocks;
+
+        /* Bytes used in the last block */
+        std::size_t _used = 0;
+
+        /* Chains a new block of at least the given size */
+        void _add_block(std::size_t bytes)
+        {
+            std::size_t size = this->_blocks.empty() ? SCRATCH_ARENA_MIN_BLOCK : 2 * this->_blocks.back().size;
+            size = std::max(size, bytes);
+            std::byte* data = static_cast<std::byte*>(::operator new[](size, std::align_val_t(SCRATCH_ARENA_ALIGNMENT)));
+            this->_blocks.push_back(Block{std::unique_ptr<std::byte[], BlockDeleter>(data), size});
+            this->_used = 0;
+        }
+
+        /* Aligned storage of the given size, valid until the next reset */
+        void* _allocate(std::size_t bytes)
+        {
+            bytes = (bytes + SCRATCH_ARENA_ALIGNMENT - 1) / SCRATCH_ARENA_ALIGNMENT * SCRATCH_ARENA_ALIGNMENT;
+            if (this->_blocks.empty() || this->_used + bytes > this->_blocks.back().size)
+            {
+                this->_add_block(bytes);
+            }
+            void* storage = this->_blocks.back().data.get() + this->_used;
+            this->_used += bytes;
+            return storage;
+        }
+
+    public:
+        ScratchArena() = default;
+        ScratchArena(const ScratchArena&) {}
+        ScratchArena& operator=(const ScratchArena&) { return *this; }
+        ScratchArena(ScratchArena&&) noexcept = default;
+        ScratchArena& operator=(ScratchArena&&) noexcept = default;
+
+        /**
+         * @brief Releases all the arrays handed out, the blocks being merged into one if the last fit
+         * needed several of them
+         */
+        void reset()
+        {
+            if (this->_blocks.size() > 1)
+            {
+                std::size_t size = 0;
+                for (const Block& block : this->_blocks) { size += block.size; }
+                this->_blocks.clear();
+                this->_add_block(size);
+            }
+            this->_used = 0;
+        }
+
+        /**
+         * @brief Uninitialized scratch vector
+         *
+         * @param n number of coefficients
+         * @return Eigen::Map<Eigen::VectorX<U>, Eigen::AlignedMax> vector valid until the next reset
+         */
+        template <typename U>
+        Eigen::Map<Eigen::VectorX<U>, Eigen::AlignedMax> vector(Eigen::Index n)
+        {
+            static_assert(std::is_trivially_destructible_v<U>, "Scratch arrays are never destroyed");
+            return Eigen::Map<Eigen::VectorX<U>, Eigen::AlignedMax>(static_cast<U*>(this->_allocate(n * sizeof(U))), n);
+        }
+
+        /**
+         * @brief Uninitialized scratch matrix (column-major)
+         *
+         * @param rows number of rows
+         * @param cols number of columns
+         * @return Eigen::Map<Eigen::MatrixX<U>, Eigen::AlignedMax> matrix valid until the next reset
+         */
+        template <typename U>
+        Eigen::Map<Eigen::MatrixX<U>, Eigen::AlignedMax> matrix(Eigen::Index rows, Eigen::Index cols)
+        {
+            static_assert(std::is_trivially_destructible_v<U>, "Scratch arrays are never destroyed");
+            return Eigen::Map<Eigen::MatrixX<U>, Eigen::AlignedMax>(static_cast<U*>(this->_allocate(rows * cols * sizeof(U))), rows, cols);
+        }
+
+        /**
+         * @brief Get the total size (in bytes) of the blocks
+         */
+        std::size_t capacity() const
+        {
+            std::size_t size = 0;
+            for (const Block& block : this->_blocks) { size += block.size; }
+            return size;
+        }
+};
@@ -0,0 +1,74 @@
+/**
+ * @file static_interpolator.hpp
+ * @brief Front end dispatching once per batch to the concrete interpolator
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <type_traits>
+#include <variant>
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "fourier_approximator.hpp"
+#include "interpolator.hpp"
+#include "lagrange_interpolator.hpp"
+
+/**
+ * @brief Static dispatch over the known interpolators. The concrete type is resolved once, at
+ * construction, into a std::variant: batches are then evaluated by the concrete operator() called
+ * without virtual dispatch, and visit() hands the concrete interpolator to a generic callable, whose
+ * per-point calls are direct calls (the query operators of the concrete interpolators are final).
+ * Other interpolators (e.g. the mapped models) are kept behind the virtual interface.
+ *
+ * @tparam T datapoints type (float, double, long double)
+ */
+template <typename T>
+class StaticInterpolator {
+
+    public:
+        using Variant = std::variant<LagrangeInterpolator<T>*, BarycentricInterpolator<T>*, CubicSplineInterpolator<T>*,
+                                     FourierApproximator<T>*, Interpolator<T>*>;
+
+    private:
+        /* Concrete interpolator, or the virtual interface as a fallback */
+        Variant _interpolator;
+
+    public:
+        /**
+         * @brief Resolves the concrete type of the interpolator (which must outlive this object)
+         *
+         * @param interpolator fitted interpolator
+         */
+        explicit StaticInterpolator(Interpolator<T>& interpolator);
+
+        /**
+         * @brief Evaluates a batch of queries, dispatched once to the concrete interpolator
+         *
+         * @param X M x 1 queries
+         * @return Eigen::VectorX<T> interpolated values
+         */
+        Eigen::VectorX<T> operator()(const Eigen::MatrixX<T>& X) const;
+
+        /**
+         * @brief Calls f with the concrete interpolator (or with the Interpolator<T> interface if its
+         * type is not known), e.g. to run a point by point loop without virtual calls
+         *
+         * @param f generic callable taking the interpolator by reference
+         * @return the result of f
+         */
+        template <typename F>
+        decltype(auto) visit(F&& f) const
+        {
+            return std::visit([&](auto* interpolator) -> decltype(auto) { return f(*interpolator); }, this->_interpolator);
+        }
+
+        /**
+         * @brief Whether the concrete type was resolved (false when falling back to virtual calls)
+         */
+        bool is_static() const { return !std::holds_alternative<Interpolator<T>*>(this->_interpolator); }
+};
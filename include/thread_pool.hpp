@@ -0,0 +1,79 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Fixed size pool of worker threads fed through a bounded task queue
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <vector>
+#include "bounded_queue.hpp"
+
+/* Maximum number of tasks waiting for a worker (submit blocks beyond) */
+#define THREAD_POOL_QUEUE_CAPACITY 1024
+
+/**
+ * @brief Runs the submitted tasks on a fixed number of worker threads. submit() blocks
+ * while THREAD_POOL_QUEUE_CAPACITY tasks are already waiting, which applies backpressure
+ * to the producer. The destructor runs the remaining queued tasks before joining.
+ *
+ * Tasks are expected to handle their own errors, exceptions escaping a task are dropped.
+ *
+ */
+class ThreadPool {
+
+    private:
+        BoundedQueue<std::function<void()>> _tasks;
+        std::vector<std::thread> _workers;
+
+    public:
+        /**
+         * @brief Starts the worker threads
+         *
+         * @param threads number of workers (at least 1)
+         * @param capacity maximum number of queued tasks
+         */
+        explicit ThreadPool(std::size_t threads, std::size_t capacity = THREAD_POOL_QUEUE_CAPACITY)
+            : _tasks(capacity)
+        {
+            threads = threads > 0 ? threads : 1;
+            for (std::size_t i=0; i<threads; i++)
+            {
+                this->_workers.emplace_back([this] {
+                    while (std::optional<std::function<void()>> task = this->_tasks.pop())
+                    {
+                        try { (*task)(); } catch (...) {}
+                    }
+                });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            this->_tasks.close();
+            for (std::thread& worker : this->_workers) { worker.join(); }
+        }
+
+        /**
+         * @brief Queues a task, waiting for a free slot if the queue is full
+         *
+         * @param task task to run on one of the workers
+         */
+        void submit(std::function<void()> task)
+        {
+            this->_tasks.push(std::move(task));
+        }
+
+        /**
+         * @brief Get the number of worker threads
+         */
+        std::size_t size() const { return this->_workers.size(); }
+};
@@ -0,0 +1,169 @@
+/**
+ * @file work_stealing_pool.hpp
+ * @brief Pool of worker threads with one task deque each, idle workers steal from the others
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs the submitted tasks on a fixed number of workers owning a deque each.
+ *
+ * Tasks submitted from outside the pool are dealt round-robin to the workers, tasks submitted
+ * by a worker go to the front of its own deque (run next, while its data is still hot). A worker
+ * takes its tasks from the front of its deque and, once empty, steals from the back of the
+ * others, so uneven tasks (e.g. files of very different sizes) keep all the workers busy.
+ *
+ * Tasks are expected to handle their own errors, exceptions escaping a task are dropped.
+ *
+ */
+class WorkStealingPool {
+
+    private:
+        struct Queue {
+            std::deque<std::function<void()>> tasks;
+            std::mutex mutex;
+        };
+
+        std::vector<std::unique_ptr<Queue>> _queues;
+        std::vector<std::thread> _workers;
+
+        /* Queued & unfinished tasks, protected by _mutex */
+        std::mutex _mutex;
+        std::condition_variable _work;
+        std::condition_variable _idle;
+        std::size_t _queued = 0;
+        std::size_t _pending = 0;
+        std::size_t _next = 0;
+        bool _stopping = false;
+
+        /* Pool & index of the worker running on the current thread */
+        inline static thread_local const WorkStealingPool* _current_pool = nullptr;
+        inline static thread_local std::size_t _current_worker = 0;
+
+        /**
+         * @brief Pops a task of the worker's own deque, or steals one from the back of another deque
+         */
+        bool _pop(std::size_t worker, std::function<void()>& task)
+        {
+            const std::size_t n = this->_queues.size();
+            for (std::size_t k=0; k<n; k++)
+            {
+                Queue& queue = *this->_queues[(worker + k) % n];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) { continue; }
+                if (k == 0)
+                {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                else
+                {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                return true;
+            }
+            return false;
+        }
+
+        void _run(std::size_t worker)
+        {
+            _current_pool = this;
+            _current_worker = worker;
+            std::function<void()> task;
+            while (true)
+            {
+                if (this->_pop(worker, task))
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(this->_mutex);
+                        this->_queued--;
+                    }
+                    try { task(); } catch (...) {}
+                    task = nullptr;
+                    std::lock_guard<std::mutex> lock(this->_mutex);
+                    if (--this->_pending == 0) { this->_idle.notify_all(); }
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(this->_mutex);
+                this->_work.wait(lock, [this] { return this->_stopping || this->_queued > 0; });
+                if (this->_stopping && this->_queued == 0) { return; }
+            }
+        }
+
+    public:
+        /**
+         * @brief Starts the workers
+         *
+         * @param threads number of workers (at least 1)
+         */
+        explicit WorkStealingPool(std::size_t threads)
+        {
+            threads = threads > 0 ? threads : 1;
+            for (std::size_t i=0; i<threads; i++) { this->_queues.push_back(std::make_unique<Queue>()); }
+            for (std::size_t i=0; i<threads; i++) { this->_workers.emplace_back([this, i] { this->_run(i); }); }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /**
+         * @brief Runs the remaining tasks and joins the workers
+         */
+        ~WorkStealingPool()
+        {
+            this->wait();
+            {
+                std::lock_guard<std::mutex> lock(this->_mutex);
+                this->_stopping = true;
+            }
+            this->_work.notify_all();
+            for (std::thread& worker : this->_workers) { worker.join(); }
+        }
+
+        /**
+         * @brief Queues a task (on the current worker's deque when called from a task of this pool)
+         *
+         * @param task task to run
+         */
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->_mutex);
+                const bool local = _current_pool == this;
+                Queue& queue = *this->_queues[local ? _current_worker : this->_next++ % this->_queues.size()];
+                std::lock_guard<std::mutex> queue_lock(queue.mutex);
+                if (local) { queue.tasks.push_front(std::move(task)); }
+                else { queue.tasks.push_back(std::move(task)); }
+                this->_queued++;
+                this->_pending++;
+            }
+            this->_work.notify_one();
+        }
+
+        /**
+         * @brief Waits until all the submitted tasks (and the tasks they submitted) are finished
+         */
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_idle.wait(lock, [this] { return this->_pending == 0; });
+        }
+
+        /**
+         * @brief Get the number of workers
+         */
+        std::size_t size() const { return this->_workers.size(); }
+};
@@ -7,6 +7,17 @@
 #include "boost/program_options.hpp"
 #include <memory>
 #include "datagen.hpp"
+#include "binary_dataset.hpp"
+#include "dataset_cache.hpp"
+#include "instrumentation.hpp"
+#include "model_io.hpp"
+#include "query_server.hpp"
+#include "chunked_reader.hpp"
+#include "data_writer.hpp"
+#include "batch_processor.hpp"
+#include "interpolation_pipeline.hpp"
+#include <csignal>
+#include <unistd.h>
 
 #define DEFAULT_DATAFOLDER_PATH "./datapoints/"
 #define DEFAULT_DATAFILE_PATH "./datapoints/default.txt"
@@ -14,34 +25,27 @@
 #define DEFAULT_NUM_POINTS 1000
 
 void interpolate_data_from_file(const std::filesystem::path& filepath);
-void generate_plot_with_factory(const std::filesystem::path& filepath, const std::string& interpolation_scheme, std::vector<std::string>& options, const int fitting_dim, int n_samples);
+void generate_plot_with_factory(const std::filesystem::path& filepath, const std::string& interpolation_scheme, std::vector<std::string>& options, const int fitting_dim, int n_samples, bool plot = true);
 void test_damped_cosine_cubic();
 void test_Chebyshev();
 
 template <typename T>
-void plot_multiple_interpolators(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params)
+void plot_multiple_interpolators(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params, bool plot = true)
 {
-    Eigen::MatrixX<T> X = DataReader<T>::read(filepath);
-
-    std::vector<std::unique_ptr<Interpolator<T>>> interpolator_objects;
+    // Parse, fit, evaluate & write on concurrent stages (data is rewritten as text since the input may be a binary dataset)
+    PipelineJob job = {filepath, std::string(OUTPUT_FOLDER) + "data.txt", {}};
     for (const auto& interpolator : interpolators)
     {
-        interpolator_objects.push_back(DataReader<T>::interpolator_from_file(filepath, interpolator, extra_params, 1));
+        job.outputs.push_back(OUTPUT_FOLDER + interpolator + "_interpolated.txt");
     }
-
-    // Generate query points
-    Eigen::MatrixX<T> X_inter(n_samples,2);
-    X_inter.col(0) = Eigen::VectorX<T>::LinSpaced(n_samples,X.col(0).minCoeff(),X.col(0).maxCoeff());
+    InterpolationPipeline<T>(interpolators, extra_params, n_samples).run({job});
 
     // Configure the plot
     std::filesystem::path paths[interpolators.size()+1];
-    paths[0] = filepath;
-    datagen<T>::write(paths[0], X);
+    paths[0] = job.data_output;
     for (int i = 1; i < interpolators.size()+1; i++)
     {
-       paths[i] = OUTPUT_FOLDER + interpolators[i-1] + "_interpolated.txt";
-        X_inter.col(1) = (*interpolator_objects[i-1])(X_inter.col(0));
-        datagen<T>::write(paths[i], X_inter);
+        paths[i] = job.outputs[i-1];
     }
 
     std::string titles[interpolators.size()+1];
@@ -58,25 +62,23 @@ void plot_multiple_interpolators(const std::filesystem::path& filepath, const st
         styles[i] = "lines";
     }
 
-    // Plot the lines
-    Plotter<T> harry_plotter;
-    harry_plotter.plot(interpolators.size()+1, paths, titles, styles);
-
-    // Clear reserved interpolator memory
-    for (int i = 0; i < interpolators.size(); i++)
+    // Plot the lines (the files are written anyway)
+    if (plot)
     {
-        interpolator_objects[i].release();
+        Plotter<T> harry_plotter;
+        harry_plotter.plot(interpolators.size()+1, paths, titles, styles);
     }
 }
 
-template void plot_multiple_interpolators<double>(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params);
-template void plot_multiple_interpolators<float>(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params);
-template void plot_multiple_interpolators<int>(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params);
+template void plot_multiple_interpolators<double>(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params, bool plot);
+template void plot_multiple_interpolators<float>(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params, bool plot);
+template void plot_multiple_interpolators<int>(const std::filesystem::path& filepath, const std::vector<std::string>& interpolators, int n_samples, std::vector<std::string>& extra_params, bool plot);
 
-void generate_plot_with_factory(const std::filesystem::path& filepath, const std::string& interpolation_scheme, std::vector<std::string>& options, const int fitting_dim, int n_samples)
+void generate_plot_with_factory(const std::filesystem::path& filepath, const std::string& interpolation_scheme, std::vector<std::string>& options, const int fitting_dim, int n_samples, bool plot)
 {
-    auto interpolator = DataReader<double>::interpolator_from_file(filepath, interpolation_scheme, options, fitting_dim);
-    Eigen::MatrixX<double> X = DataReader<double>::read(filepath);
+    auto dataset = DatasetCache<double>::global().get(filepath);
+    const Eigen::MatrixX<double>& X = *dataset;
+    auto interpolator = DataReader<double>::interpolator_from_data(X, interpolation_scheme, options, fitting_dim);
 
     // Generate query points
     Eigen::MatrixX2d X_inter(n_samples,2);
@@ -91,14 +93,150 @@ void generate_plot_with_factory(const std::filesystem::path& filepath, const std
     std::string titles[2] = {"data", "interpolated"};
     std::string styles[2] = {"points", "lines"};
 
-    // Plot the lines
-    Plotter<double> harry_plotter;
-    harry_plotter.plot(2, paths, titles, styles);
+    // Plot the lines (the files are written anyway)
+    if (plot)
+    {
+        Plotter<double> harry_plotter;
+        harry_plotter.plot(2, paths, titles, styles);
+    }
 
     // Clear reserved interpolator memory
     interpolator.release();
 }
 
+/**
+ * @brief Evaluates the interpolators fitted on the data file at the queries of a query file (or of stdin),
+ * chunk by chunk, and streams the "x y_1 ... y_k" rows to the output file. The whole query set is never
+ * held in memory and nothing is plotted.
+ * 
+ * @param data_path data file to fit the interpolators on
+ * @param interpolators interpolation schemes
+ * @param extra_params cubic spline options
+ * @param query query file in the datapoints format (first column used) or "-" for stdin
+ * @param output output file (binary dataset if the extension is .bin) or "-" for stdout
+ */
+void evaluate_query_file(const std::filesystem::path& data_path, const std::vector<std::string>& interpolators, const std::vector<std::string>& extra_params,
+                         const std::string& query, const std::string& output)
+{
+    auto dataset = DatasetCache<double>::global().get(data_path);
+    std::vector<std::unique_ptr<Interpolator<double>>> interpolator_objects;
+    for (const auto& interpolator : interpolators)
+    {
+        interpolator_objects.push_back(DataReader<double>::interpolator_from_data(*dataset, interpolator, extra_params, 1));
+    }
+
+    std::unique_ptr<ChunkedReader<double>> reader = (query == "-") ? std::make_unique<ChunkedReader<double>>(std::cin)
+                                                                   : std::make_unique<ChunkedReader<double>>(query);
+    const std::filesystem::path output_path = (output == "-") ? "/dev/stdout" : output;
+    const DataFormat format = (output_path.extension() == ".bin") ? DataFormat::BINARY : DataFormat::TEXT;
+    DataWriter<double> writer(output_path, reader->rows(), interpolator_objects.size()+1, format, -1, std::thread::hardware_concurrency());
+
+    Eigen::MatrixXd chunk, queries, results;
+    while (reader->next(chunk))
+    {
+        queries = chunk.leftCols(1);
+        results.resize(chunk.rows(), interpolator_objects.size()+1);
+        results.col(0) = queries.col(0);
+        for (std::size_t i = 0; i < interpolator_objects.size(); i++)
+        {
+            results.col(i+1) = (*interpolator_objects[i])(queries);
+        }
+        writer.write_rows(results);
+    }
+    writer.close();
+}
+
+/**
+ * @brief Converts a text data file to the binary dataset format, or a binary dataset back to text
+ * 
+ * @param input input data file
+ * @param output converted data file
+ */
+void convert_data_file(const std::filesystem::path& input, const std::filesystem::path& output)
+{
+    if (is_binary_dataset(input))
+    {
+        datagen<double>::write(output, BinaryDataset<double>::read(input));
+    }
+    else
+    {
+        BinaryDataset<double>::write(output, DataReader<double>::read(input));
+    }
+}
+
+/**
+ * @brief Prints the statistics counters (registered with atexit by --stats)
+ */
+void print_stats()
+{
+    if (!Stats::enabled())
+    {
+        std::cerr << "Statistics are not compiled in, configure with -DINTERPOLATION_STATS=ON" << std::endl;
+        return;
+    }
+    std::cerr << Stats::snapshot().to_string();
+}
+
+/* Server stopped by SIGINT/SIGTERM in --serve mode */
+QueryServer<double>* active_server = nullptr;
+
+void stop_query_server(int)
+{
+    if (active_server) { active_server->stop(); }
+}
+
+/**
+ * @brief Loads the models given as name=path (saved model file) or name=scheme:path (fitted on a data file)
+ * and serves them on stdin/stdout ("-") or on the given Unix socket until end of input or SIGINT/SIGTERM
+ * 
+ * @param endpoint "-" or socket path
+ * @param models model specifications
+ * @param workers number of worker threads
+ * @param extra_params cubic spline options of the fitted models
+ */
+void run_query_server(const std::string& endpoint, const std::vector<std::string>& models, unsigned int workers, const std::vector<std::string>& extra_params)
+{
+    QueryServer<double> server(workers);
+    for (const std::string& spec : models)
+    {
+        const std::size_t equal = spec.find('=');
+        if (equal == std::string::npos)
+        {
+            throw QueryServerException(std::format("Invalid model '{}', expected name=path or name=scheme:path", spec), __func__);
+        }
+        const std::string name = spec.substr(0, equal);
+        const std::string source = spec.substr(equal + 1);
+        const std::size_t colon = source.find(':');
+        const std::string scheme = colon == std::string::npos ? "" : source.substr(0, colon);
+        if (scheme == "lagrange" || scheme == "barycentric" || scheme == "cubic_spline" || scheme == "fourier")
+        {
+            Eigen::MatrixXd X = DataReader<double>::read(source.substr(colon + 1));
+            server.add_model(name, DataReader<double>::interpolator_from_data(X, scheme, extra_params, 1));
+        }
+        else
+        {
+            server.add_model(name, ModelIO<double>::load(source));
+        }
+        std::cerr << "Serving model '" << name << "'" << std::endl;
+    }
+
+    // A client closing its connection must not kill the server
+    std::signal(SIGPIPE, SIG_IGN);
+    if (endpoint == "-")
+    {
+        server.serve(STDIN_FILENO, STDOUT_FILENO);
+    }
+    else
+    {
+        active_server = &server;
+        std::signal(SIGINT, stop_query_server);
+        std::signal(SIGTERM, stop_query_server);
+        server.serve_socket(endpoint);
+        active_server = nullptr;
+    }
+    std::cerr << server.latency().to_string();
+}
+
 int main(int argc, char **argv) {
 
     // Read command line arguments using boost::program_options
@@ -109,9 +247,19 @@ int main(int argc, char **argv) {
                         ("file", boost::program_options::value<std::string>(), "interpolation data file (relative path)")
                         ("lagrange", "use Lagrange interpolation")
                         ("barycentric", "use barycentric interpolation")
+                        ("fourier", "use trigonometric interpolation of equispaced periodic data")
                         ("cubic_spline", boost::program_options::value<std::vector<std::string>>()->multitoken(), 
                         "cubic spline interpolation with boundary conditions [NATURAL, NOT_A_KNOT, CLAMPED]")
-                        ("samples", boost::program_options::value<int>(), "number of samples to generate");
+                        ("samples", boost::program_options::value<int>(), "number of samples to generate")
+                        ("convert", boost::program_options::value<std::string>(), "convert the data file to the binary format (or back to text if binary) into the given path")
+                        ("query", boost::program_options::value<std::string>(), "evaluate the interpolators at the queries of this file (- for stdin) instead of a grid, without plotting")
+                        ("output", boost::program_options::value<std::string>(), "output file of --query (- for stdout, binary if the extension is .bin) or output directory of --dir")
+                        ("no-plot", "write the interpolated grid files without plotting them")
+                        ("stats", "print the interpolation statistics counters on exit")
+                        ("serve", boost::program_options::value<std::string>()->implicit_value("-"), "serve the models on stdin/stdout (-) or on the given Unix socket path")
+                        ("model", boost::program_options::value<std::vector<std::string>>()->composing(), "model to serve: name=path (saved model) or name=scheme:path (fitted on a data file)")
+                        ("dir", boost::program_options::value<std::string>()->implicit_value(DEFAULT_DATAFOLDER_PATH), "fit & evaluate the interpolators on every data file of the directory (default ./datapoints/), without plotting")
+                        ("workers", boost::program_options::value<unsigned int>(), "number of worker threads of the server or of --dir (default: number of cores)");
 
         boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc, boost::program_options::command_line_style::unix_style ^  boost::program_options::command_line_style::allow_short), vmap);
         boost::program_options::notify(vmap);
@@ -129,6 +277,22 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    if (vmap.count("stats"))
+    {
+        std::atexit(print_stats);
+    }
+
+    if (vmap.count("serve")) {
+        std::vector<std::string> models = {};
+        if (vmap.count("model")) { models = vmap["model"].as<std::vector<std::string>>(); }
+        std::vector<std::string> extra_params = {};
+        if (vmap.count("cubic_spline")) { extra_params = vmap["cubic_spline"].as<std::vector<std::string>>(); }
+        unsigned int workers = std::thread::hardware_concurrency();
+        if (vmap.count("workers")) { workers = vmap["workers"].as<unsigned int>(); }
+        run_query_server(vmap["serve"].as<std::string>(), models, workers, extra_params);
+        return 0;
+    }
+
     // Create output folder if needed
     if (!std::filesystem::exists(OUTPUT_FOLDER))
     {
@@ -140,6 +304,11 @@ int main(int argc, char **argv) {
         data_path = std::filesystem::current_path().concat("/").concat(vmap["file"].as<std::string>());
     }
 
+    if (vmap.count("convert")) {
+        convert_data_file(data_path, vmap["convert"].as<std::string>());
+        return 0;
+    }
+
     int num_samples = DEFAULT_NUM_POINTS;
     if (vmap.count("samples")) {
         num_samples = vmap["samples"].as<int>();
@@ -150,21 +319,39 @@ int main(int argc, char **argv) {
     if (vmap.count("lagrange")) { interpolators.push_back("lagrange"); }
     if (vmap.count("barycentric")) { interpolators.push_back("barycentric"); }
     if (vmap.count("cubic_spline")) { interpolators.push_back("cubic_spline"); }
+    if (vmap.count("fourier")) { interpolators.push_back("fourier"); }
 
-    if (interpolators.size() > 0) {
-        std::vector<std::string> extra_params = {};
-        if (vmap.count("cubic_spline") > 0) {
-            extra_params = vmap["cubic_spline"].as<std::vector<std::string>>();
-        }
-        plot_multiple_interpolators<double>(data_path, interpolators, num_samples, extra_params);
+    std::vector<std::string> extra_params = {};
+    if (vmap.count("cubic_spline") > 0) {
+        extra_params = vmap["cubic_spline"].as<std::vector<std::string>>();
+    }
+
+    if (vmap.count("query")) {
+        std::string output = std::string(OUTPUT_FOLDER) + "query_interpolated.txt";
+        if (vmap.count("output")) { output = vmap["output"].as<std::string>(); }
+        if (interpolators.empty()) { interpolators.push_back("lagrange"); }
+        evaluate_query_file(data_path, interpolators, extra_params, vmap["query"].as<std::string>(), output);
         return 0;
     }
 
-    if (vmap.empty())
-    {
-        std::vector<std::string> options= {};
-        generate_plot_with_factory(data_path, "lagrange", options, 1, num_samples);
+    if (vmap.count("dir")) {
+        std::filesystem::path output_dir = std::string(OUTPUT_FOLDER) + "batch/";
+        if (vmap.count("output")) { output_dir = vmap["output"].as<std::string>(); }
+        unsigned int workers = std::thread::hardware_concurrency();
+        if (vmap.count("workers")) { workers = vmap["workers"].as<unsigned int>(); }
+        BatchProcessor<double> batch(interpolators, extra_params, num_samples, workers);
+        std::cout << batch.run(vmap["dir"].as<std::string>(), output_dir).to_string();
+        return 0;
+    }
+
+    const bool plot = !vmap.count("no-plot");
+    if (interpolators.size() > 0) {
+        plot_multiple_interpolators<double>(data_path, interpolators, num_samples, extra_params, plot);
         return 0;
     }
+
+    // Lagrange by default
+    generate_plot_with_factory(data_path, "lagrange", extra_params, 1, num_samples, plot);
+    return 0;
 }
 
@@ -1,17 +1,19 @@
 #include "barycentric_interpolator.hpp"
 #include "project_exceptions.hpp"
+#include "interpolation_kernels.hpp"
+#include <type_traits>
 
-template <typename T>
-BarycentricInterpolator<T>::BarycentricInterpolator() {}
+template <typename T, typename S>
+BarycentricInterpolator<T, S>::BarycentricInterpolator() {}
 
-template <typename T>
-T BarycentricInterpolator<T>::_barycentric_weight(unsigned int i, unsigned int j) 
+template <typename T, typename S>
+T BarycentricInterpolator<T, S>::_barycentric_weight(unsigned int i, unsigned int j) 
 {
     throw std::runtime_error("FUNCTION NOT YET IMPLEMENTED ==> barycentric_weight");
 }
 
-template <typename T>
-T BarycentricInterpolator<T>::_barycentric_weight(unsigned int i) 
+template <typename T, typename S>
+T BarycentricInterpolator<T, S>::_barycentric_weight(unsigned int i) 
 {
     // Check if X data is multidimensional
     if (this->_X_data.cols() > 1)
@@ -35,109 +37,113 @@ T BarycentricInterpolator<T>::_barycentric_weight(unsigned int i)
     return 1.0 / wi;
 }
 
-template <typename T>
-void BarycentricInterpolator<T>::add_data(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y)
+template <typename T, typename S>
+void BarycentricInterpolator<T, S>::add_data(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y)
 {
     if (X.cols() > 1)
     {
         throw BarycentricInterpolatorException::MultidimensionalImplementation("No multidimensional support yet for barycentric interpolation!", __func__);
     }
-    // Extends existing data
-    Eigen::MatrixX<T> new_X_data(this->_X_data.rows() + X.rows(), this->_X_data.cols());
-    Eigen::VectorX<T> new_y_data(this->_y_data.rows() + y.rows());
-    new_X_data << this->_X_data, X;
-    new_y_data << this->_y_data, y;
+    const Eigen::Index old_n = this->_X_data.rows();
+    const Eigen::Index k = X.rows();
+    this->_scratch.reset();
 
-    // 1D case
-    // First update all previous weights
-    Eigen::MatrixX<T> new_weights(this->_weights.rows() + X.rows(), this->_weights.cols());
-    for (unsigned int i=0; i<this->_weights.rows();i++)
+    // New nodes (as stored) & the factors of all the weights, computed before the model is modified
+    auto new_X = this->_scratch.template vector<T>(k);
+    new_X = X.col(0).template cast<S>().template cast<T>();
+    auto old_factors = this->_scratch.template vector<T>(old_n);
+    auto new_factors = this->_scratch.template vector<T>(k);
+    // First the previous weights, divided by their products with the new nodes
+    for (Eigen::Index i=0; i<old_n; i++)
     {
         T new_wi=1;
-        for (unsigned int k=0; k<X.rows(); k++)
+        for (Eigen::Index j=0; j<k; j++)
         {
-            new_wi *= (this->_X_data(i,0) - X(k,0));
+            new_wi *= (T(this->_X_data(i,0)) - new_X(j));
             if (new_wi == 0)
             {
                 throw BarycentricInterpolatorException::DivisionByZero("Cannot add an already existing interpolation datapoint!", __func__);
             }
         }
-        new_weights(i,0) = this->_weights(i,0) / new_wi;
+        old_factors(i) = new_wi;
     }
-    // Second compute new weights w_k
-    for (unsigned int k= this->_X_data.rows()-1; k<new_X_data.rows(); k++)
+    // Second the new weights w_k, products with all the other nodes
+    for (Eigen::Index j=0; j<k; j++)
     {
         T new_wi=1;
-        for (unsigned int i=0; i<new_X_data.rows(); i++)
+        for (Eigen::Index i=0; i<old_n+k; i++)
         {
-            if (i != k)
+            if (i != old_n+j)
             {
-                new_wi *= (new_X_data(k,0) - new_X_data(i,0));
+                new_wi *= (new_X(j) - (i < old_n ? T(this->_X_data(i,0)) : new_X(i-old_n)));
                 if (new_wi == 0)
                 {
                     throw BarycentricInterpolatorException::DivisionByZero("Cannot add an already existing interpolation datapoint!", __func__);
                 }
             }
         }
-        new_weights(k,0) = 1 / new_wi;
+        new_factors(j) = new_wi;
     }
 
-    // Sets new data
-    this->_X_data = new_X_data;
-    this->_y_data = new_y_data;
-    this->_weights = new_weights;
+    // Extends existing data in place (the model storage grows, the temporaries come from the scratch arena)
+    this->_X_data.conservativeResize(old_n + k, Eigen::NoChange);
+    this->_y_data.conservativeResize(old_n + k);
+    this->_weights.conservativeResize(old_n + k, Eigen::NoChange);
+    this->_X_data.col(0).tail(k) = new_X.template cast<S>();
+    this->_y_data.tail(k) = y.template cast<S>();
+    for (Eigen::Index i=0; i<old_n; i++)
+    {
+        this->_weights(i,0) = S(T(this->_weights(i,0)) / old_factors(i));
+    }
+    for (Eigen::Index j=0; j<k; j++)
+    {
+        this->_weights(old_n+j,0) = S(this->_weights_scale / new_factors(j));
+    }
 
     // Readjust range
     this->_calculate_range();
 }
 
-template <typename T>
-void BarycentricInterpolator<T>::add_data(T x, T y)
+template <typename T, typename S>
+void BarycentricInterpolator<T, S>::add_data(T x, T y)
 {
-    // Add new values to X and y data
-    Eigen::MatrixX<T> new_X_data(this->_X_data.rows() + 1, this->_X_data.cols());
-    Eigen::VectorX<T> new_y_data(this->_y_data.rows() + 1);
-    new_X_data << this->_X_data, x;
-    new_y_data << this->_y_data, y;
+    // x as stored
+    x = T(S(x));
+    const Eigen::Index n = this->_X_data.rows();
 
-    // First update all previous weights
-    Eigen::MatrixX<T> new_weights(this->_weights.rows() + 1, this->_weights.cols());
-    for (unsigned int i=0; i<this->_weights.rows();i++)
+    // Compute the new weight w_k first, so that the model is unchanged if x is already a node
+    T new_wi=1;
+    for (Eigen::Index i=0; i<n; i++)
     {
-        T new_wi = this->_X_data(i,0) - x;
+        new_wi *= (x - T(this->_X_data(i,0)));
         if (new_wi == 0)
         {
             throw BarycentricInterpolatorException::DivisionByZero("Cannot add an already existing interpolation datapoint!", __func__);
         }
-        new_weights(i,0) = this->_weights(i,0) / new_wi;
     }
 
-    // Second compute new weight w_k
-    T new_wi=1;
-    for (unsigned int i=0; i<this->_X_data.rows(); i++)
+    // Add new values to X and y data in place & update all previous weights
+    this->_X_data.conservativeResize(n + 1, Eigen::NoChange);
+    this->_y_data.conservativeResize(n + 1);
+    this->_weights.conservativeResize(n + 1, Eigen::NoChange);
+    this->_X_data(n,0) = S(x);
+    this->_y_data(n) = S(y);
+    for (Eigen::Index i=0; i<n; i++)
     {
-        new_wi *= (x - this->_X_data(i,0));
-        if (new_wi == 0)
-        {
-            throw BarycentricInterpolatorException::DivisionByZero("Cannot add an already existing interpolation datapoint!", __func__);
-        }
+        this->_weights(i,0) = S(T(this->_weights(i,0)) / (T(this->_X_data(i,0)) - x));
     }
-    new_weights(Eigen::placeholders::last, 0) = 1 / new_wi;
-
-    // Sets new data
-    this->_X_data = new_X_data;
-    this->_y_data = new_y_data;
-    this->_weights = new_weights;
+    this->_weights(n,0) = S(this->_weights_scale / new_wi);
 
     // Readjust range
     this->_calculate_range();
 }
 
-template <typename T>
-void BarycentricInterpolator<T>::fit(const Eigen::MatrixX<T>& X, unsigned int dim) 
+template <typename T, typename S>
+void BarycentricInterpolator<T, S>::fit(const Eigen::MatrixX<T>& X, unsigned int dim) 
 {
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
     // Store datapoints
-    PolynomialInterpolator<T>::fit(X, dim);
+    PolynomialInterpolator<T, S>::fit(X, dim);
     // Compute the weights
     if (this->_X_data.cols() > 1)
     {
@@ -145,19 +151,22 @@ void BarycentricInterpolator<T>::fit(const Eigen::MatrixX<T>& X, unsigned int di
     }
     else
     {   
-        this->_weights = Eigen::MatrixX<T>(this->_X_data.rows(),1);
+        this->_scratch.reset();
+        auto weights = this->_scratch.template vector<T>(this->_X_data.rows());
         for (unsigned int i=0; i<this->_X_data.rows(); i++)
         {
-            this->_weights(i,0) = this->_barycentric_weight(i);
+            weights(i) = this->_barycentric_weight(i);
         }
+        this->_store_weights(weights);
     }
 }
 
-template <typename T>
-void BarycentricInterpolator<T>::fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) 
+template <typename T, typename S>
+void BarycentricInterpolator<T, S>::fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) 
 {
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
     // Store datapoints
-    PolynomialInterpolator<T>::fit(X, y);
+    PolynomialInterpolator<T, S>::fit(X, y);
     // Compute the weights
     if (X.cols() > 1)
     {
@@ -165,16 +174,30 @@ void BarycentricInterpolator<T>::fit(const Eigen::MatrixX<T>& X, const Eigen::Ve
     }
     else
     {
-        this->_weights = Eigen::MatrixX<T>(X.rows(),1);
+        this->_scratch.reset();
+        auto weights = this->_scratch.template vector<T>(X.rows());
         for (unsigned int i=0; i<X.rows(); i++)
         {
-            _weights(i,0) = this->_barycentric_weight(i);
+            weights(i) = this->_barycentric_weight(i);
         }
+        this->_store_weights(weights);
+    }
+}
+
+template <typename T, typename S>
+void BarycentricInterpolator<T, S>::_store_weights(const Eigen::Ref<const Eigen::VectorX<T>>& weights)
+{
+    this->_weights_scale = 1;
+    if constexpr (!std::is_same_v<S, T>)
+    {
+        const T largest = weights.cwiseAbs().maxCoeff();
+        if (largest > 0 && std::isfinite(largest)) { this->_weights_scale = 1 / largest; }
     }
+    this->_weights = (weights * this->_weights_scale).template cast<S>();
 }
 
-template <typename T>
-Eigen::VectorX<T> BarycentricInterpolator<T>::operator()(const Eigen::MatrixX<T>& X) 
+template <typename T, typename S>
+Eigen::VectorX<T> BarycentricInterpolator<T, S>::operator()(const Eigen::MatrixX<T>& X) 
 {
     // Check for corresponding dimensions (m)
     if (X.cols() != this->_X_data.cols())
@@ -185,43 +208,50 @@ Eigen::VectorX<T> BarycentricInterpolator<T>::operator()(const Eigen::MatrixX<T>
     {
         throw BarycentricInterpolatorException::MultidimensionalImplementation("No multidimensional support yet for barycentric interpolation!", __func__);
     }
-    // Loop through all values
-    Eigen::VectorX<T> y(X.rows());
-    for (unsigned int i=0; i<X.rows(); i++)
+    // The kernel is selected once per batch & inlined in the loop, the model arrays being hoisted
+    const S* nodes = this->_X_data.data();
+    const S* values = this->_y_data.data();
+    const S* weights = this->_weights.data();
+    const Eigen::Index n = this->_X_data.rows();
+    if (this->_summation_mode == SummationMode::COMPENSATED)
     {
-        y(i) = this->operator()(X(i,0));
-    } 
-    return y;
+        return this->_evaluate_batch(X.col(0), this->_extrapolation_policy, __func__,
+                                     [=](T x) { return barycentric_kernel_compensated(x, nodes, values, weights, n); });
+    }
+    return this->_evaluate_batch(X.col(0), this->_extrapolation_policy, __func__,
+                                 [=](T x) { return barycentric_kernel(x, nodes, values, weights, n); });
 }
 
-template <typename T>
-T BarycentricInterpolator<T>::operator()(T x) 
+template <typename T, typename S>
+T BarycentricInterpolator<T, S>::operator()(T x) 
 {
+    INTERPOLATION_STATS_ADD(QUERIES, 1);
     // Check if x within the interpolation range
     if (x > this->_X_max(0) || x < this->_X_min(0))
     {
-        throw BarycentricInterpolatorException::Extrapolation(x, this->_X_min(0), this->_X_max(0), __func__);
+        return this->_extrapolate(x, this->_extrapolation_policy, __func__);
     }
+    return this->_evaluate(x);
+}
 
-    T weighted_sum=0, sum=0;
-    T intermediate = 0;
-    for (unsigned int j=0; j<this->_X_data.rows(); j++) 
+template <typename T, typename S>
+T BarycentricInterpolator<T, S>::_evaluate(T x) 
+{
+    if (this->_summation_mode == SummationMode::COMPENSATED)
     {
-        // Check if the querry point is an exact point
-        if (x - this->_X_data(j,0) == 0)
-        {
-            weighted_sum = this->_y_data(j);
-            sum = 1;
-            break;
-        }
-        intermediate = this->_weights(j,0) / (x - this->_X_data(j,0));
-        sum += intermediate;
-        weighted_sum += intermediate * this->_y_data(j);
+        return barycentric_kernel_compensated(x, this->_X_data.data(), this->_y_data.data(), this->_weights.data(), this->_X_data.rows());
     }
-    return weighted_sum / sum;
+    return barycentric_kernel(x, this->_X_data.data(), this->_y_data.data(), this->_weights.data(), this->_X_data.rows());
+}
+
+template <typename T, typename S>
+const Eigen::MatrixX<S>& BarycentricInterpolator<T, S>::get_weights() const
+{
+    return this->_weights;
 }
 
 template class BarycentricInterpolator<int>;
 template class BarycentricInterpolator<float>;
 template class BarycentricInterpolator<double>;
-template class BarycentricInterpolator<long double>;
\ No newline at end of file
+template class BarycentricInterpolator<long double>;
+template class BarycentricInterpolator<double, float>;
\ No newline at end of file
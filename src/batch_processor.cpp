@@ -0,0 +1,161 @@
+#include "batch_processor.hpp"
+#include "data_reader.hpp"
+#include "data_writer.hpp"
+#include "project_exceptions.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+std::string BatchSummary::to_string() const
+{
+    const double seconds = std::max(this->seconds, 1e-9);
+    std::string summary = std::format("files: {} ({} failed) | datapoints: {} | read: {:.2f} MiB | evaluations: {} | wall: {:.3f} s\n"
+                                      "throughput: {:.1f} files/s | {:.2f} MiB/s | {:.3g} evaluations/s\n",
+                                      this->files, this->failed, this->datapoints, this->bytes_read / 1048576.0, this->evaluations,
+                                      this->seconds, (this->files - this->failed) / seconds, this->bytes_read / 1048576.0 / seconds,
+                                      this->evaluations / seconds);
+    for (const std::string& error : this->errors)
+    {
+        summary += "failed: " + error + "\n";
+    }
+    return summary;
+}
+
+template <typename T>
+BatchProcessor<T>::BatchProcessor(const std::vector<std::string>& interpolators, const std::vector<std::string>& options,
+                                  Eigen::Index samples, std::size_t workers)
+    : _interpolators(interpolators), _options(options), _samples(samples), _workers(workers)
+{
+    if (this->_interpolators.empty()) { this->_interpolators.push_back("lagrange"); }
+    if (this->_samples < 2) { this->_samples = 2; }
+}
+
+template <typename T>
+std::vector<std::filesystem::path> BatchProcessor<T>::discover(const std::filesystem::path& dir)
+{
+    if (!std::filesystem::is_directory(dir))
+    {
+        throw DataReaderException::FileNotFound(dir.string());
+    }
+    std::vector<std::filesystem::path> files;
+    auto it = std::filesystem::recursive_directory_iterator(dir, std::filesystem::directory_options::skip_permission_denied);
+    for (; it != std::filesystem::recursive_directory_iterator(); ++it)
+    {
+        const bool hidden = it->path().filename().string().starts_with(".");
+        if (hidden && it->is_directory()) { it.disable_recursion_pending(); }
+        if (!hidden && it->is_regular_file()) { files.push_back(it->path()); }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+template <typename T>
+std::filesystem::path BatchProcessor<T>::output_path(const std::filesystem::path& file, const std::filesystem::path& dir,
+                                                     const std::filesystem::path& output_dir)
+{
+    std::filesystem::path relative = file.lexically_relative(dir);
+    // data.txt.gz -> data.txt
+    if (relative.extension() == ".gz" || relative.extension() == ".zst") { relative.replace_extension(); }
+    return output_dir / relative.replace_extension(".txt");
+}
+
+template <typename T>
+Eigen::Index BatchProcessor<T>::_process(const std::filesystem::path& file, const std::filesystem::path& output) const
+{
+    const Eigen::MatrixX<T> X = DataReader<T>::read(file);
+
+    Eigen::MatrixX<T> results(this->_samples, this->_interpolators.size()+1);
+    results.col(0) = Eigen::VectorX<T>::LinSpaced(this->_samples, X.col(0).minCoeff(), X.col(0).maxCoeff());
+    for (std::size_t i = 0; i < this->_interpolators.size(); i++)
+    {
+        std::unique_ptr<Interpolator<T>> interpolator = DataReader<T>::interpolator_from_data(X, this->_interpolators[i], this->_options, 1);
+        results.col(i+1) = (*interpolator)(results.leftCols(1));
+    }
+    DataWriter<T>::write(output, results);
+    return X.rows();
+}
+
+template <typename T>
+BatchSummary BatchProcessor<T>::run(const std::filesystem::path& dir, const std::filesystem::path& output_dir) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::filesystem::path> files = discover(dir);
+
+    // Inputs sharing a stem (a.txt, a.bin, a.txt.gz) map to the same output, which the workers would
+    // write concurrently. None of them is processed, they are all reported as failed.
+    std::map<std::filesystem::path, std::vector<std::filesystem::path>> outputs;
+    for (const std::filesystem::path& file : files)
+    {
+        outputs[output_path(file, dir, output_dir)].push_back(file);
+    }
+
+    BatchSummary summary;
+    summary.files = files.size();
+    std::size_t shared_outputs = 0;
+
+    // Largest files first, the small ones fill the gaps at the end of the run
+    std::vector<std::tuple<std::uintmax_t, std::filesystem::path, std::filesystem::path>> jobs;
+    for (const auto& [output, inputs] : outputs)
+    {
+        if (inputs.size() > 1)
+        {
+            for (const std::filesystem::path& file : inputs)
+            {
+                shared_outputs++;
+                if (summary.errors.size() < BATCH_REPORTED_ERRORS)
+                {
+                    summary.errors.push_back(std::format("{}: output '{}' is shared by {} input files", file.string(), output.string(), inputs.size()));
+                }
+            }
+            continue;
+        }
+        std::error_code error;
+        const std::uintmax_t size = std::filesystem::file_size(inputs[0], error);
+        jobs.emplace_back(error ? 0 : size, inputs[0], output);
+        // Output directories are created upfront, not concurrently by the workers
+        std::filesystem::create_directories(output.parent_path());
+    }
+    std::stable_sort(jobs.begin(), jobs.end(), [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+
+    std::atomic<std::size_t> failed = shared_outputs;
+    std::atomic<std::uint64_t> datapoints = 0;
+    std::atomic<std::uint64_t> bytes_read = 0;
+    std::mutex errors_mutex;
+    {
+        WorkStealingPool pool(this->_workers);
+        for (const auto& [size, file, output] : jobs)
+        {
+            pool.submit([&, size, file, output] {
+                try
+                {
+                    datapoints += this->_process(file, output);
+                    bytes_read += size;
+                }
+                catch (const std::exception& e)
+                {
+                    failed++;
+                    std::lock_guard<std::mutex> lock(errors_mutex);
+                    if (summary.errors.size() < BATCH_REPORTED_ERRORS) { summary.errors.push_back(file.string() + ": " + e.what()); }
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    summary.failed = failed;
+    summary.datapoints = datapoints;
+    summary.bytes_read = bytes_read;
+    summary.evaluations = (summary.files - summary.failed) * this->_samples * this->_interpolators.size();
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+template class BatchProcessor<float>;
+template class BatchProcessor<double>;
+template class BatchProcessor<long double>;
@@ -0,0 +1,153 @@
+#include "binary_dataset.hpp"
+#include "project_exceptions.hpp"
+#include <cstring>
+#include <fstream>
+#include <format>
+
+template <> DatasetType dataset_type<int>() { return DatasetType::INT32; }
+template <> DatasetType dataset_type<float>() { return DatasetType::FLOAT32; }
+template <> DatasetType dataset_type<double>() { return DatasetType::FLOAT64; }
+template <> DatasetType dataset_type<long double>() { return DatasetType::LONG_DOUBLE; }
+
+std::uint32_t dataset_type_size(DatasetType dtype)
+{
+    switch (dtype)
+    {
+        case DatasetType::INT32: return sizeof(int);
+        case DatasetType::FLOAT32: return sizeof(float);
+        case DatasetType::FLOAT64: return sizeof(double);
+        case DatasetType::LONG_DOUBLE: return sizeof(long double);
+        default: return 0;
+    }
+}
+
+template <typename T>
+BinaryDatasetHeader make_binary_dataset_header(std::uint64_t rows, std::uint64_t cols)
+{
+    BinaryDatasetHeader header = {};
+    std::memcpy(header.magic, BINARY_DATASET_MAGIC, sizeof(header.magic));
+    header.version = BINARY_DATASET_VERSION;
+    header.dtype = dataset_type<T>();
+    header.layout = DatasetLayout::COL_MAJOR;
+    header.element_size = sizeof(T);
+    header.rows = rows;
+    header.cols = cols;
+    return header;
+}
+
+template BinaryDatasetHeader make_binary_dataset_header<int>(std::uint64_t, std::uint64_t);
+template BinaryDatasetHeader make_binary_dataset_header<float>(std::uint64_t, std::uint64_t);
+template BinaryDatasetHeader make_binary_dataset_header<double>(std::uint64_t, std::uint64_t);
+template BinaryDatasetHeader make_binary_dataset_header<long double>(std::uint64_t, std::uint64_t);
+
+bool is_binary_dataset(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) && std::memcmp(magic, BINARY_DATASET_MAGIC, sizeof(magic)) == 0;
+}
+
+BinaryDatasetHeader read_binary_dataset_header(const std::filesystem::path& path)
+{
+    if (!std::filesystem::exists(path)) { throw DataReaderException::FileNotFound(path.c_str()); }
+    std::ifstream file(path, std::ios::binary);
+    BinaryDatasetHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (file.gcount() != sizeof(header) || std::memcmp(header.magic, BINARY_DATASET_MAGIC, sizeof(header.magic)) != 0)
+    {
+        throw DataReaderException("Not a binary dataset file!", __func__);
+    }
+    if (header.version != BINARY_DATASET_VERSION)
+    {
+        throw DataReaderException(std::format("Unsupported binary dataset version {}! Expected {}", header.version, BINARY_DATASET_VERSION), __func__);
+    }
+    if (header.layout != DatasetLayout::COL_MAJOR)
+    {
+        throw DataReaderException("Unsupported binary dataset layout!", __func__);
+    }
+    // Also rejects unknown types, whose size is 0
+    if (header.element_size != dataset_type_size(header.dtype))
+    {
+        throw DataReaderException("Corrupted binary dataset header --> element size does not match the type!", __func__);
+    }
+    if (header.cols == 0)
+    {
+        throw DataReaderException("Corrupted binary dataset header!", __func__);
+    }
+    // Compared with divisions so that huge dimensions cannot wrap around
+    const std::uintmax_t payload_size = std::filesystem::file_size(path) - sizeof(header);
+    if (header.cols > payload_size / header.element_size
+        || header.rows > payload_size / (header.cols * header.element_size))
+    {
+        throw DataReaderException("Binary dataset file is truncated --> wrong data size!", __func__);
+    }
+    return header;
+}
+
+template <typename T>
+MappedDataset<T>::MappedDataset(const std::filesystem::path& path)
+    : _header(read_binary_dataset_header(path))
+{
+    if (this->_header.dtype != dataset_type<T>() || this->_header.element_size != sizeof(T))
+    {
+        throw DataReaderException::InvalidType("Binary dataset type does not match the requested type!", __func__);
+    }
+    this->_file.open(path.string());
+}
+
+template <typename T>
+Eigen::Map<const Eigen::MatrixX<T>> MappedDataset<T>::matrix() const
+{
+    const T* data = reinterpret_cast<const T*>(this->_file.data() + sizeof(BinaryDatasetHeader));
+    return Eigen::Map<const Eigen::MatrixX<T>>(data, this->rows(), this->cols());
+}
+
+template <typename T>
+void BinaryDataset<T>::write(const std::filesystem::path& path, const Eigen::MatrixX<T>& data)
+{
+    BinaryDatasetHeader header = make_binary_dataset_header<T>(data.rows(), data.cols());
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error(std::format("[writer] :: The provided file could not be opened! --> '{}'", path.c_str()));
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+}
+
+template <typename T>
+MappedDataset<T> BinaryDataset<T>::map(const std::filesystem::path& path)
+{
+    return MappedDataset<T>(path);
+}
+
+template <typename T>
+Eigen::MatrixX<T> BinaryDataset<T>::read(const std::filesystem::path& path)
+{
+    // Convert from the stored type if needed
+    switch (read_binary_dataset_header(path).dtype)
+    {
+        case DatasetType::INT32:
+            return MappedDataset<int>(path).matrix().template cast<T>();
+        case DatasetType::FLOAT32:
+            return MappedDataset<float>(path).matrix().template cast<T>();
+        case DatasetType::FLOAT64:
+            return MappedDataset<double>(path).matrix().template cast<T>();
+        case DatasetType::LONG_DOUBLE:
+            return MappedDataset<long double>(path).matrix().template cast<T>();
+        default:
+            throw DataReaderException::InvalidType("Unknown binary dataset type!", __func__);
+    }
+}
+
+template class MappedDataset<long double>;
+template class MappedDataset<double>;
+template class MappedDataset<float>;
+template class MappedDataset<int>;
+
+template struct BinaryDataset<long double>;
+template struct BinaryDataset<double>;
+template struct BinaryDataset<float>;
+template struct BinaryDataset<int>;
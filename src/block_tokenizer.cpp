@@ -0,0 +1,75 @@
+#include "block_tokenizer.hpp"
+#include <charconv>
+#include <cstring>
+
+inline bool is_space(char c)
+{ return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+BlockTokenizer::BlockTokenizer(std::istream& stream, std::size_t block_size)
+    : _stream(stream), _buffer(block_size), _block_size(block_size)
+{}
+
+bool BlockTokenizer::_refill(std::size_t keep_from)
+{
+    // Move the partial token to the front of the buffer
+    std::size_t kept = this->_end - keep_from;
+    if (kept > 0 && keep_from > 0)
+    {
+        std::memmove(this->_buffer.data(), this->_buffer.data() + keep_from, kept);
+    }
+    // Grow only if a single token is larger than the block size
+    if (this->_buffer.size() < kept + this->_block_size)
+    {
+        this->_buffer.resize(kept + this->_block_size);
+    }
+    this->_pos -= keep_from;
+    this->_end = kept;
+
+    if (!this->_stream) { return false; }
+    this->_stream.read(this->_buffer.data() + kept, this->_block_size);
+    std::size_t count = this->_stream.gcount();
+    this->_end += count;
+    this->_bytes_read += count;
+    return count > 0;
+}
+
+std::string_view BlockTokenizer::next()
+{
+    // Skip leading whitespace
+    while (true)
+    {
+        while (this->_pos < this->_end && is_space(this->_buffer[this->_pos])) { this->_pos++; }
+        if (this->_pos < this->_end) { break; }
+        if (!this->_refill(this->_end)) { return {}; }
+    }
+    // Scan the token, refilling if it reaches the end of the buffer
+    std::size_t start = this->_pos;
+    while (true)
+    {
+        while (this->_pos < this->_end && !is_space(this->_buffer[this->_pos])) { this->_pos++; }
+        if (this->_pos < this->_end) { break; }
+        // The partial token is moved to the front of the buffer by the refill
+        bool refilled = this->_refill(start);
+        start = 0;
+        if (!refilled) { break; }
+    }
+    return std::string_view(this->_buffer.data() + start, this->_pos - start);
+}
+
+template <typename T>
+bool BlockTokenizer::parse(std::string_view token, T& value)
+{
+    const char* first = token.data();
+    const char* last = token.data() + token.size();
+    // from_chars does not accept an explicit '+' sign
+    if (first != last && *first == '+') { first++; }
+    if (first == last) { return false; }
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && ptr == last;
+}
+
+template bool BlockTokenizer::parse<int>(std::string_view, int&);
+template bool BlockTokenizer::parse<long>(std::string_view, long&);
+template bool BlockTokenizer::parse<float>(std::string_view, float&);
+template bool BlockTokenizer::parse<double>(std::string_view, double&);
+template bool BlockTokenizer::parse<long double>(std::string_view, long double&);
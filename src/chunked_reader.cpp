@@ -0,0 +1,121 @@
+#include "chunked_reader.hpp"
+#include "data_reader.hpp"
+#include "compressed_input.hpp"
+#include "project_exceptions.hpp"
+#include <algorithm>
+#include <format>
+
+template <typename T>
+ChunkedReader<T>::ChunkedReader(const std::filesystem::path& path, Eigen::Index chunk_rows)
+    : _chunk_rows(chunk_rows)
+{
+    if (chunk_rows <= 0) { throw DataReaderException("Chunk size must be positive!", __func__); }
+    if (!std::filesystem::exists(path)) { throw DataReaderException::FileNotFound(path.c_str()); }
+
+    if (is_binary_dataset(path))
+    {
+        this->_binary = true;
+        // Rejects headers whose element size does not match dtype, the payload is mapped as dtype values
+        this->_header = read_binary_dataset_header(path);
+        this->_rows = this->_header.rows;
+        this->_cols = this->_header.cols;
+        this->_mapping.open(path.string());
+        return;
+    }
+
+    Compression compression = detect_compression(path);
+    if (compression != Compression::NONE)
+    {
+        this->_owned_stream = std::make_unique<DecompressingStream>(path, compression);
+        this->_open_text(*this->_owned_stream);
+        return;
+    }
+
+    auto file = std::make_unique<std::ifstream>(path);
+    if (!file->is_open())
+    {
+        throw std::runtime_error(std::format("[reader] :: The provided file could not be opened! --> '{}'", path.c_str()));
+    }
+    this->_owned_stream = std::move(file);
+    this->_open_text(*this->_owned_stream);
+}
+
+template <typename T>
+ChunkedReader<T>::ChunkedReader(std::istream& stream, Eigen::Index chunk_rows)
+    : _chunk_rows(chunk_rows)
+{
+    if (chunk_rows <= 0) { throw DataReaderException("Chunk size must be positive!", __func__); }
+    this->_open_text(stream);
+}
+
+template <typename T>
+void ChunkedReader<T>::_open_text(std::istream& stream)
+{
+    this->_tokenizer = std::make_unique<BlockTokenizer>(stream);
+    std::tie(this->_rows, this->_cols) = DataReader<T>::read_header(*this->_tokenizer);
+}
+
+template <typename T>
+template <typename U>
+void ChunkedReader<T>::_copy_binary_rows(Eigen::MatrixX<T>& chunk, Eigen::Index first) const
+{
+    const U* data = reinterpret_cast<const U*>(this->_mapping.data() + sizeof(BinaryDatasetHeader));
+    Eigen::Map<const Eigen::MatrixX<U>> matrix(data, this->_rows, this->_cols);
+    chunk = matrix.middleRows(first, chunk.rows()).template cast<T>();
+}
+
+template <typename T>
+bool ChunkedReader<T>::next(Eigen::MatrixX<T>& chunk)
+{
+    const Eigen::Index remaining = this->_rows - this->_next_row;
+    if (remaining <= 0) { return false; }
+
+    chunk.resize(std::min(remaining, this->_chunk_rows), this->_cols);
+    if (this->_binary)
+    {
+        switch (this->_header.dtype)
+        {
+            case DatasetType::INT32: this->_copy_binary_rows<int>(chunk, this->_next_row); break;
+            case DatasetType::FLOAT32: this->_copy_binary_rows<float>(chunk, this->_next_row); break;
+            case DatasetType::FLOAT64: this->_copy_binary_rows<double>(chunk, this->_next_row); break;
+            case DatasetType::LONG_DOUBLE: this->_copy_binary_rows<long double>(chunk, this->_next_row); break;
+            default: throw DataReaderException::InvalidType("Unknown binary dataset type!", __func__);
+        }
+    }
+    else
+    {
+        DataReader<T>::read_rows(*this->_tokenizer, chunk);
+    }
+    this->_next_row += chunk.rows();
+    return true;
+}
+
+template <typename T>
+Eigen::Index evaluate_chunks(Interpolator<T>& interpolator, ChunkedReader<T>& reader,
+                             const std::function<void(const Eigen::MatrixX<T>&, const Eigen::VectorX<T>&)>& sink,
+                             unsigned int query_dim)
+{
+    if (query_dim >= reader.cols())
+    {
+        throw InterpolationProjectException::IndexOutOfBounds(query_dim, reader.cols()-1, __func__);
+    }
+    Eigen::MatrixX<T> chunk;
+    Eigen::Index count = 0;
+    while (reader.next(chunk))
+    {
+        Eigen::VectorX<T> values = interpolator(Eigen::MatrixX<T>(chunk.col(query_dim)));
+        sink(chunk, values);
+        count += chunk.rows();
+    }
+    return count;
+}
+
+template class ChunkedReader<long double>;
+template class ChunkedReader<double>;
+template class ChunkedReader<float>;
+template class ChunkedReader<int>;
+
+template Eigen::Index evaluate_chunks<long double>(Interpolator<long double>&, ChunkedReader<long double>&, const std::function<void(const Eigen::MatrixX<long double>&, const Eigen::VectorX<long double>&)>&, unsigned int);
+template Eigen::Index evaluate_chunks<double>(Interpolator<double>&, ChunkedReader<double>&, const std::function<void(const Eigen::MatrixX<double>&, const Eigen::VectorX<double>&)>&, unsigned int);
+template Eigen::Index evaluate_chunks<float>(Interpolator<float>&, ChunkedReader<float>&, const std::function<void(const Eigen::MatrixX<float>&, const Eigen::VectorX<float>&)>&, unsigned int);
+template Eigen::Index evaluate_chunks<int>(Interpolator<int>&, ChunkedReader<int>&, const std::function<void(const Eigen::MatrixX<int>&, const Eigen::VectorX<int>&)>&, unsigned int);
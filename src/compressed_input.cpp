@@ -0,0 +1,120 @@
+#include "compressed_input.hpp"
+#include "project_exceptions.hpp"
+#include <boost/iostreams/filtering_streambuf.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#ifdef INTERPOLATION_HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+#include <cstring>
+#include <format>
+#include <fstream>
+
+Compression detect_compression(const std::filesystem::path& path)
+{
+    // Magic bytes first
+    unsigned char magic[4] = {};
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    if (file.gcount() >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) { return Compression::GZIP; }
+    if (file.gcount() == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) { return Compression::ZSTD; }
+
+    // The magic bytes are trusted whenever the file is long enough to hold them
+    if (file.gcount() == sizeof(magic)) { return Compression::NONE; }
+
+    // Fall back on the extension (missing or too short file)
+    const std::string extension = path.extension().string();
+    if (extension == ".gz" || extension == ".gzip") { return Compression::GZIP; }
+    if (extension == ".zst" || extension == ".zstd") { return Compression::ZSTD; }
+    return Compression::NONE;
+}
+
+bool zstd_supported()
+{
+#ifdef INTERPOLATION_HAVE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+DecompressingBuffer::DecompressingBuffer(const std::filesystem::path& path, Compression compression)
+    : _blocks(DECOMPRESSION_QUEUE_SIZE)
+{
+    if (!std::filesystem::exists(path)) { throw DataReaderException::FileNotFound(path.c_str()); }
+    if (compression == Compression::ZSTD && !zstd_supported())
+    {
+        throw DataReaderException("Cannot read zstd compressed files, zstd support was not compiled in!", __func__);
+    }
+    this->_decoder = std::thread(&DecompressingBuffer::_decode, this, path, compression);
+}
+
+DecompressingBuffer::~DecompressingBuffer()
+{
+    // Unblocks the decoder if it is waiting for a free slot
+    this->_blocks.close();
+    if (this->_decoder.joinable()) { this->_decoder.join(); }
+}
+
+void DecompressingBuffer::_decode(std::filesystem::path path, Compression compression)
+{
+    try
+    {
+        std::ifstream file(path, std::ios::binary);
+        boost::iostreams::filtering_istreambuf input;
+        switch (compression)
+        {
+            case Compression::GZIP:
+                input.push(boost::iostreams::gzip_decompressor());
+                break;
+#ifdef INTERPOLATION_HAVE_ZSTD
+            case Compression::ZSTD:
+                input.push(boost::iostreams::zstd_decompressor());
+                break;
+#endif
+            default:
+                break;
+        }
+        input.push(file);
+
+        while (true)
+        {
+            std::vector<char> block(DECOMPRESSION_BLOCK_SIZE);
+            std::streamsize count = input.sgetn(block.data(), block.size());
+            if (count <= 0) { break; }
+            block.resize(count);
+            // Queue closed: the reader is gone
+            if (!this->_blocks.push(std::move(block))) { return; }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        this->_error = std::make_exception_ptr(DataReaderException(std::format("Could not decompress '{}' --> {}", path.c_str(), e.what()), "DataReader"));
+    }
+    // Empty block marks the end of the data
+    this->_blocks.push(std::vector<char>());
+}
+
+DecompressingBuffer::int_type DecompressingBuffer::underflow()
+{
+    if (this->gptr() < this->egptr()) { return traits_type::to_int_type(*this->gptr()); }
+    if (this->_finished) { return traits_type::eof(); }
+
+    std::optional<std::vector<char>> block = this->_blocks.pop();
+    if (!block || block->empty())
+    {
+        this->_finished = true;
+        if (this->_error) { std::rethrow_exception(this->_error); }
+        return traits_type::eof();
+    }
+    this->_current = std::move(*block);
+    this->setg(this->_current.data(), this->_current.data(), this->_current.data() + this->_current.size());
+    return traits_type::to_int_type(*this->gptr());
+}
+
+DecompressingStream::DecompressingStream(const std::filesystem::path& path, Compression compression)
+    : std::istream(nullptr), _buffer(path, compression)
+{
+    this->rdbuf(&this->_buffer);
+    // Let decompression errors reach the caller instead of silently ending the stream
+    this->exceptions(std::ios::badbit);
+}
@@ -1,15 +1,17 @@
 #include "cubic_spline_interpolator.hpp"
+#include "interpolation_kernels.hpp"
+#include <algorithm>
 
-template <typename T>
-CubicSplineInterpolator<T>::CubicSplineInterpolator() {
+template <typename T, typename S>
+CubicSplineInterpolator<T, S>::CubicSplineInterpolator() {
     if (std::is_same<T, int>::value) {
         throw CubicSplineInterpolatorException::InvalidType("CubicSplineInterpolator doesn't support int type", __func__);
     }
     boundary_constraint = BoundaryConstraint::NATURAL;
 }
 
-template <typename T>
-CubicSplineInterpolator<T>::CubicSplineInterpolator(BoundaryConstraint boundary){
+template <typename T, typename S>
+CubicSplineInterpolator<T, S>::CubicSplineInterpolator(BoundaryConstraint boundary){
     if (boundary == BoundaryConstraint::CLAMPED) {
         std::cerr << "Warning: Clamped boundary condition requires boundary values and none were provided. Using 0,0. Can set them using set_clamped_values" << std::endl;
         this->clamped_values = Eigen::Vector2<T>(0, 0);
@@ -18,8 +20,8 @@ CubicSplineInterpolator<T>::CubicSplineInterpolator(BoundaryConstraint boundary)
     boundary_constraint = boundary;
 }
 
-template <typename T>
-CubicSplineInterpolator<T>::CubicSplineInterpolator(BoundaryConstraint boundary, const Eigen::Vector2<T>& clamped_values){ 
+template <typename T, typename S>
+CubicSplineInterpolator<T, S>::CubicSplineInterpolator(BoundaryConstraint boundary, const Eigen::Vector2<T>& clamped_values){ 
     
     if (boundary != BoundaryConstraint::CLAMPED) {
         std::cerr << "Warning: Non-clamped boundary condition provided with clamped values. Ignoring clamped values." << std::endl;
@@ -30,24 +32,26 @@ CubicSplineInterpolator<T>::CubicSplineInterpolator(BoundaryConstraint boundary,
     boundary_constraint = boundary;
 }
 
-template <typename T>
-void CubicSplineInterpolator<T>::_apply_boundary_conditions(Eigen::MatrixX<T> &A, Eigen::VectorX<T> &b, Eigen::VectorX<T> &f, Eigen::VectorX<T> &h) 
+template <typename T, typename S>
+void CubicSplineInterpolator<T, S>::_apply_boundary_conditions(Eigen::Ref<Eigen::VectorX<T>> lower, Eigen::Ref<Eigen::VectorX<T>> diag,
+                                                               Eigen::Ref<Eigen::VectorX<T>> upper, Eigen::Ref<Eigen::VectorX<T>> b,
+                                                               const Eigen::Ref<const Eigen::VectorX<T>>& f, const Eigen::Ref<const Eigen::VectorX<T>>& h)
 {
-    int n = A.rows();
+    int n = diag.rows();
     switch (boundary_constraint) {
         case BoundaryConstraint::NATURAL:
-            A(0, 0) = 1;
-            A(n - 1, n - 1) = 1;
+            diag(0) = 1;
+            upper(0) = 0;
+            diag(n - 1) = 1;
+            lower(n - 1) = 0;
             b(0) = 0;
             b(n - 1) = 0;
             break;
         case BoundaryConstraint::CLAMPED:
-            A(0, 0) = 2*h(0);
-            A(0, 1) = h(0);
-            A(1, 0) = h(0);
-            A(n - 1, n - 1) = 2*h(n - 2);
-            A(n - 1, n - 2) = h(n - 2);
-            A(n - 2, n - 1) = h(n - 2);
+            diag(0) = 2*h(0);
+            upper(0) = h(0);
+            diag(n - 1) = 2*h(n - 2);
+            lower(n - 1) = h(n - 2);
             b(0) = 3*(f(0) - clamped_values(0));
             b(n - 1) = 3*(clamped_values(1) - f(n - 2));
             break;
@@ -58,9 +62,10 @@ void CubicSplineInterpolator<T>::_apply_boundary_conditions(Eigen::MatrixX<T> &A
     }
 }
 
-template <typename T>
-void CubicSplineInterpolator<T>::fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx) 
+template <typename T, typename S>
+void CubicSplineInterpolator<T, S>::fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx) 
 {
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
     int n, m;
     n = X.rows();
     m = X.cols();
@@ -76,132 +81,150 @@ void CubicSplineInterpolator<T>::fit(const Eigen::MatrixX<T>& X, unsigned int di
         throw CubicSplineInterpolatorException::InterpolationProjectException("Single dimension data not supported", __func__);
     }
 
-    Eigen::VectorX<T> y = X.col(dim_idx);
+    // Columns fitted without copies
     int other_dim = ! (bool) dim_idx;
-    Eigen::VectorX<T> x = X.col(other_dim);
-    this->fit(x, y);
+    this->_fit(X.col(other_dim), X.col(dim_idx));
 }
 
-template <typename T>
-void CubicSplineInterpolator<T>::fit(const Eigen::VectorX<T>& X, const Eigen::VectorX<T>& y) 
+template <typename T, typename S>
+void CubicSplineInterpolator<T, S>::fit(const Eigen::VectorX<T>& X, const Eigen::VectorX<T>& y) 
 {
-    this->_X_max = Eigen::VectorX<T>(1); // TODO: code for multi dim data
-    this->_X_min = Eigen::VectorX<T>(1);
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
+    this->_fit(X, y);
+}
 
-    this->_X_data = X;
-    this->_y_data = y;
+template <typename T, typename S>
+void CubicSplineInterpolator<T, S>::_fit(const Eigen::Ref<const Eigen::VectorX<T>>& X, const Eigen::Ref<const Eigen::VectorX<T>>& y)
+{
+    this->_X_data = X.template cast<S>();
+    this->_y_data = y.template cast<S>();
+    this->_calculate_range(); // TODO: code for multi dim data
 
-    this->_X_max << X.maxCoeff();
-    this->_X_min << X.minCoeff();
+    // The temporaries are drawn from the scratch arena: refitting the same number of knots does not allocate
+    this->_scratch.reset();
+    int n = this->_X_data.rows();
 
-    int n = X.rows();
-    Eigen::MatrixX<T> A = Eigen::MatrixX<T>::Zero(n, n);
-    Eigen::VectorX<T> v = Eigen::VectorX<T>::Zero(n);
+    // Fitted on the knots & values as stored, so that the segments match the evaluation
+    auto knots = this->_scratch.template vector<T>(n);
+    auto values = this->_scratch.template vector<T>(n);
+    knots = this->_X_data.col(0).template cast<T>();
+    values = this->_y_data.template cast<T>();
 
     // diff: h[i] = x[i+1] - x[i]
-    Eigen::VectorX<T> h = X.tail(n-1) - X.head(n-1);
+    auto h = this->_scratch.template vector<T>(n-1);
+    h = knots.tail(n-1) - knots.head(n-1);
 
     // Newton divided diff: f[i] = (y[i+1] - y[i]) / h[i]
-    Eigen::VectorX<T> f = (y.tail(n-1) - y.head(n-1)).cwiseQuotient(h);
-
-    this->_apply_boundary_conditions(A, v, f, h);
-
-    // build A 
-    Eigen::MatrixX<T> inner_A = A.block(1, 1, n - 2, n - 2);
-    inner_A.diagonal(0)  = 2*(h.head(n-2) + h.tail(n-2));
-    inner_A.diagonal(1)  = h.segment(1, n-3);
-    inner_A.diagonal(-1) = h.segment(1, n-3);
-    // insert back into A
-    A.block(1, 1, n - 2, n - 2) = inner_A; 
-
-    // build b
-    v.segment(1, n - 2) = 3*(f.tail(n-2) - f.head(n-2));
-
-
-    // solve for coefficients
-    Eigen::VectorX<T> c = A.fullPivLu().solve(v);
-    Eigen::VectorX<T> d = (c.tail(n-1) - c.head(n-1)).cwiseQuotient(3*h);
-    Eigen::VectorX<T> b = f - h.cwiseProduct(2*c.head(n-1) + c.tail(n-1))/3;
-    Eigen::VectorX<T> a = y.head(n-1);
-    this->coefficients = Eigen::MatrixX4<T>(n-1, 4);
-    this->coefficients << a, b, c.head(n-1), d;
-
-}
-
-template <typename T>
-int CubicSplineInterpolator<T>::_get_index(T x) 
-{
-    
-    T xmin = this->_X_min(0);
-    T xmax = this->_X_max(0);
-
-    if (x < xmin || x > xmax) {
-        throw CubicSplineInterpolatorException::Extrapolation(x, xmin, xmax, __func__);
+    auto f = this->_scratch.template vector<T>(n-1);
+    f = (values.tail(n-1) - values.head(n-1)).cwiseQuotient(h);
+
+    // build the tridiagonal system A c = v, row i being h[i-1] c[i-1] + 2 (h[i-1] + h[i]) c[i] + h[i] c[i+1]
+    auto lower = this->_scratch.template vector<T>(n);
+    auto diag = this->_scratch.template vector<T>(n);
+    auto upper = this->_scratch.template vector<T>(n);
+    auto c = this->_scratch.template vector<T>(n);
+    lower.segment(1, n - 2) = h.head(n-2);
+    diag.segment(1, n - 2) = 2*(h.head(n-2) + h.tail(n-2));
+    upper.segment(1, n - 2) = h.tail(n-2);
+    c.segment(1, n - 2) = 3*(f.tail(n-2) - f.head(n-2));
+    this->_apply_boundary_conditions(lower, diag, upper, c, f, h);
+
+    // solve for coefficients (Thomas algorithm, the system being diagonally dominant), c overwriting v
+    for (int i = 1; i < n; i++)
+    {
+        const T w = lower(i) / diag(i-1);
+        diag(i) -= w * upper(i-1);
+        c(i) -= w * c(i-1);
     }
-
-    int n = this->_X_data.rows();
-    int guess = (int) (x - xmin) / (xmax - xmin) * n;
-    
-    auto is_in_bin = [&](int idx) {return this->_X_data(idx) <= x && x < this->_X_data(idx + 1);};
-
-    int idx = guess;
-
-    while (idx < n-1 && idx > 0 && !is_in_bin(idx)) {
-        if (x < this->_X_data(idx)) {
-            idx--;
-        } else {
-            idx++;
-        }
+    c(n-1) /= diag(n-1);
+    for (int i = n - 2; i >= 0; i--)
+    {
+        c(i) = (c(i) - upper(i) * c(i+1)) / diag(i);
     }
-    idx = idx < 0 ? 0 : idx;
-    idx = idx >= n-1 ? n-2 : idx;
-    return idx;
 
+    // a, b, c, d columns, written in place
+    this->coefficients.resize(n-1, 4);
+    this->coefficients.col(0) = values.head(n-1).template cast<S>();
+    this->coefficients.col(1) = (f - h.cwiseProduct(2*c.head(n-1) + c.tail(n-1))/3).template cast<S>();
+    this->coefficients.col(2) = c.head(n-1).template cast<S>();
+    this->coefficients.col(3) = (c.tail(n-1) - c.head(n-1)).cwiseQuotient(3*h).template cast<S>();
 }
 
-template <typename T>
-Eigen::VectorX<T> CubicSplineInterpolator<T>::operator()(const Eigen::MatrixX<T>& X) 
+template <typename T, typename S>
+Eigen::VectorX<T> CubicSplineInterpolator<T, S>::operator()(const Eigen::MatrixX<T>& X) 
 {
     if (X.cols() > 1) {
         throw CubicSplineInterpolatorException::MultidimensionalImplementation("Multidimensional data not supported", __func__);
     }
+    // The kernel is selected once per batch & inlined in the loop, the model arrays being hoisted
+    const S* knots = this->_X_data.data();
+    const S* coefficients = this->coefficients.data();
+    const Eigen::Index n = this->_X_data.rows();
+    const T x_min = this->_X_min(0), x_max = this->_X_max(0);
+    if (this->_summation_mode == SummationMode::COMPENSATED)
+    {
+        return this->_evaluate_batch(X.col(0), this->_extrapolation_policy, __func__,
+                                     [=](T x) { return spline_kernel_compensated(x, knots, coefficients, n, x_min, x_max); });
+    }
+    return this->_evaluate_batch(X.col(0), this->_extrapolation_policy, __func__,
+                                 [=](T x) { return spline_kernel(x, knots, coefficients, n, x_min, x_max); });
+}
 
-    Eigen::VectorX<T> y = Eigen::VectorX<T>(X.rows());
-    for (int i = 0; i < X.rows(); i++) {
-        y(i) = this->operator()(X(i));
+template <typename T, typename S>
+T CubicSplineInterpolator<T, S>::operator()(T x) 
+{
+    INTERPOLATION_STATS_ADD(QUERIES, 1);
+    if (x < this->_X_min(0) || x > this->_X_max(0)) {
+        return this->_extrapolate(x, this->_extrapolation_policy, __func__);
     }
-    return y;
+    return this->_evaluate(x);
 }
 
-template <typename T>
-T CubicSplineInterpolator<T>::operator()(T x) 
+template <typename T, typename S>
+T CubicSplineInterpolator<T, S>::_evaluate(T x) 
 {
-    int i = this->_get_index(x);
-    Eigen::Vector4<T> coeffs = this->coefficients.row(i);
-    T dx = x - this->_X_data(i);
-    return coeffs(0) + coeffs(1)*dx + coeffs(2)*dx*dx + coeffs(3)*dx*dx*dx;
+    if (this->_summation_mode == SummationMode::COMPENSATED)
+    {
+        return spline_kernel_compensated(x, this->_X_data.data(), this->coefficients.data(), this->_X_data.rows(), this->_X_min(0), this->_X_max(0));
+    }
+    return spline_kernel(x, this->_X_data.data(), this->coefficients.data(), this->_X_data.rows(), this->_X_min(0), this->_X_max(0));
 }
 
-template <typename T>
-void CubicSplineInterpolator<T>::set_clamped_values(const Eigen::Vector2<T>& values) {
+template <typename T, typename S>
+void CubicSplineInterpolator<T, S>::set_clamped_values(const Eigen::Vector2<T>& values) {
     this->clamped_values = values;
 }
 
-template <typename T>
-void CubicSplineInterpolator<T>::set_clamped_values(T lower, T upper) {
+template <typename T, typename S>
+void CubicSplineInterpolator<T, S>::set_clamped_values(T lower, T upper) {
     this->clamped_values = Eigen::Vector2<T>(lower, upper);
 }
 
-template <typename T>
-CubicSplineInterpolator<T>::BoundaryConstraint CubicSplineInterpolator<T>::get_constraint_from_string(const std::string& b_constraint)
+template <typename T, typename S>
+const Eigen::MatrixX4<S>& CubicSplineInterpolator<T, S>::get_coefficients() const {
+    return this->coefficients;
+}
+
+template <typename T, typename S>
+CubicSplineInterpolator<T, S>::BoundaryConstraint CubicSplineInterpolator<T, S>::get_boundary_constraint() const {
+    return this->boundary_constraint;
+}
+
+template <typename T, typename S>
+const Eigen::Vector2<T>& CubicSplineInterpolator<T, S>::get_clamped_values() const {
+    return this->clamped_values;
+}
+
+template <typename T, typename S>
+CubicSplineInterpolator<T, S>::BoundaryConstraint CubicSplineInterpolator<T, S>::get_constraint_from_string(const std::string& b_constraint)
 {
     const auto to_uppercase = [](std::string& s) {return std::transform(s.begin(), s.end(), s.begin(),
                                                                         [](char c) {return std::toupper(c); }); };
     std::string b_const_normalized(b_constraint);
     to_uppercase(b_const_normalized);
-    if (b_const_normalized == "NATURAL") { return CubicSplineInterpolator<T>::BoundaryConstraint::NATURAL; }
-    if (b_const_normalized == "NOT_A_KNOT") { return CubicSplineInterpolator<T>::BoundaryConstraint::NOT_A_KNOT; }
-    if (b_const_normalized == "CLAMPED") { return CubicSplineInterpolator<T>::BoundaryConstraint::CLAMPED; }
+    if (b_const_normalized == "NATURAL") { return CubicSplineInterpolator<T, S>::BoundaryConstraint::NATURAL; }
+    if (b_const_normalized == "NOT_A_KNOT") { return CubicSplineInterpolator<T, S>::BoundaryConstraint::NOT_A_KNOT; }
+    if (b_const_normalized == "CLAMPED") { return CubicSplineInterpolator<T, S>::BoundaryConstraint::CLAMPED; }
     else { throw CubicSplineInterpolatorException::InvalidType("Cannot convert to a known boundary condition!", __func__);}
 }
 
@@ -209,4 +232,5 @@ CubicSplineInterpolator<T>::BoundaryConstraint CubicSplineInterpolator<T>::get_c
 template class CubicSplineInterpolator<long double>;
 template class CubicSplineInterpolator<double>;
 template class CubicSplineInterpolator<float>;
+template class CubicSplineInterpolator<double, float>;
 // template class CubicSplineInterpolator<int>;
@@ -1,12 +1,17 @@
 #include "data_reader.hpp"
 #include "interpolators.hpp"
 #include "project_exceptions.hpp"
+#include "block_tokenizer.hpp"
+#include "binary_dataset.hpp"
+#include "dataset_cache.hpp"
+#include "compressed_input.hpp"
 #include <format>
 #include <sstream>
 #include <string>	
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <algorithm>
 
 inline void check_path(const std::filesystem::path& path) 
 { std::filesystem::exists(path) ?  : throw DataReaderException::FileNotFound(path.c_str()); }
@@ -16,6 +21,22 @@ Eigen::MatrixX<T> DataReader<T>::read(const std::filesystem::path& path) {
     // Check if file exists
     check_path(path);
 
+    // Compressed text files are decompressed on the fly
+    Compression compression = detect_compression(path);
+    if (compression != Compression::NONE)
+    {
+        DecompressingStream stream(path, compression);
+        return DataReader<T>::read(stream);
+    }
+
+    // Binary datasets are mapped instead of parsed
+    if (is_binary_dataset(path))
+    {
+        INTERPOLATION_STATS_SCOPE(FILES_READ, READ_NS);
+        INTERPOLATION_STATS_ADD(BYTES_READ, std::filesystem::file_size(path));
+        return BinaryDataset<T>::read(path);
+    }
+
     std::ifstream file(path);
     // Verify file is opened
     if (!file.is_open()) 
@@ -27,44 +48,60 @@ Eigen::MatrixX<T> DataReader<T>::read(const std::filesystem::path& path) {
 
 template <typename T>
 Eigen::MatrixX<T> DataReader<T>::read(std::ifstream &file) {
-    int rows, cols;
-    std::string s;
-    // Sanity check for numbers
-    const auto is_numeric = [](const std::string& s) {return !s.empty() && std::all_of(s.begin(), s.end(), [](const char c) { return std::isdigit(c); }); };
-    
-    file >> s;
-    if (s != "#") { throw DataReaderException("Parameter line does not start with #!"); }
-    file >> s;
-    if (!is_numeric(s)) { throw DataReaderException::NotANumber(s); }
-    rows = std::atoi(s.data());
-    file >> s;
-    if (!is_numeric(s)) { throw DataReaderException::NotANumber(s); }
-    cols = std::atoi(s.data());
+    Eigen::MatrixX<T> data = DataReader<T>::read(static_cast<std::istream&>(file));
+    file.close();
+    return data;
+}
 
+template <typename T>
+Eigen::MatrixX<T> DataReader<T>::read(std::istream &stream) {
+    INTERPOLATION_STATS_SCOPE(FILES_READ, READ_NS);
+    BlockTokenizer tokenizer(stream);
+    auto [rows, cols] = DataReader<T>::read_header(tokenizer);
     Eigen::MatrixX<T> data(rows, cols);
-    std::string s_val;
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
+    DataReader<T>::read_rows(tokenizer, data);
+    INTERPOLATION_STATS_ADD(BYTES_READ, tokenizer.bytes_read());
+    return data;
+}
+
+template <typename T>
+std::pair<Eigen::Index, Eigen::Index> DataReader<T>::read_header(BlockTokenizer &tokenizer) {
+    Eigen::Index rows, cols;
+    // Sanity check for numbers
+    const auto is_numeric = [](std::string_view s) {return !s.empty() && std::all_of(s.begin(), s.end(), [](const char c) { return std::isdigit(c); }); };
+
+    std::string_view token = tokenizer.next();
+    if (token != "#") { throw DataReaderException("Parameter line does not start with #!"); }
+    token = tokenizer.next();
+    if (!is_numeric(token) || !BlockTokenizer::parse(token, rows)) { throw DataReaderException::NotANumber(std::string(token)); }
+    token = tokenizer.next();
+    if (!is_numeric(token) || !BlockTokenizer::parse(token, cols)) { throw DataReaderException::NotANumber(std::string(token)); }
+    return std::make_pair(rows, cols);
+}
+
+template <typename T>
+void DataReader<T>::read_rows(BlockTokenizer &tokenizer, Eigen::MatrixX<T> &data) {
+    for (Eigen::Index i = 0; i < data.rows(); i++) {
+        for (Eigen::Index j = 0; j < data.cols(); j++) {
+            std::string_view token = tokenizer.next();
             // Check if reached eof before filling up the data matrix
-            if (file.eof()) {throw DataReaderException("End of data file reached before filling matrix --> wrong data size!"); }
-            file >> s_val;
-            // Using stringstream in order to keep original string value if conversion to T fails
-            std::stringstream ss_val(s_val);
-            T value;
-            if(! (ss_val >> value)) { throw DataReaderException::NotANumber(s_val); }
-            data(i, j) = value;
+            if (token.empty()) { throw DataReaderException("End of data file reached before filling matrix --> wrong data size!"); }
+            if (!BlockTokenizer::parse(token, data(i, j))) { throw DataReaderException::NotANumber(std::string(token)); }
         }
     }
-    file.close();
-    return data;
 }
 
 template <typename T>
-std::unique_ptr<Interpolator<T>> DataReader<T>::interpolator_from_file(const std::filesystem::path& path, const std::string& interpolator, std::vector<std::string>& options, const int fitting_dim)
+std::unique_ptr<Interpolator<T>> DataReader<T>::interpolator_from_file(const std::filesystem::path& path, const std::string& interpolator, const std::vector<std::string>& options, const int fitting_dim)
 {
-    // Read data
-    Eigen::MatrixX<T> X = DataReader<T>::read(path);
+    // Read data (parsed once per file & shared between calls)
+    auto X = DatasetCache<T>::global().get(path);
+    return DataReader<T>::interpolator_from_data(*X, interpolator, options, fitting_dim);
+}
 
+template <typename T>
+std::unique_ptr<Interpolator<T>> DataReader<T>::interpolator_from_data(const Eigen::MatrixX<T>& X, const std::string& interpolator, const std::vector<std::string>& options, const int fitting_dim)
+{
     // Construct interpolator object
     std::string interpolation_scheme = interpolator;
     const auto to_uppercase = [](std::string& s) {return std::transform(s.begin(), s.end(), s.begin(),
@@ -102,7 +139,7 @@ std::unique_ptr<Interpolator<T>> DataReader<T>::interpolator_from_file(const std
                             throw DataReaderException("Insufficiant number of parameters for cubic_spline with 'CLAMPED' boundaries! Should be 2", __func__);
                         }
                         // Reading special case for 'clamped' conditions
-                        std::stringstream ss(options[1].append(" ").append(options[2]));
+                        std::stringstream ss(options[1] + " " + options[2]);
                         Eigen::Vector2<T> v;
                         ss >> v(0);
                         ss >> v(1);
@@ -121,6 +158,19 @@ std::unique_ptr<Interpolator<T>> DataReader<T>::interpolator_from_file(const std
                 return inter;
             }
     }
+    if (interpolation_scheme == "FOURIER")
+    {
+            if constexpr (std::is_same<T, int>::value)
+            {
+                throw InterpolationProjectException::InvalidType("FourierApproximator does not support int type!", __func__);
+            }
+            else
+            {
+                std::unique_ptr<FourierApproximator<T>> inter(new FourierApproximator<T>);
+                inter->fit(X, fitting_dim);
+                return inter;
+            }
+    }
     else
     {
         throw DataReaderException("Unknown interpolator type!");
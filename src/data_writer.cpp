@@ -0,0 +1,162 @@
+#include "data_writer.hpp"
+#include "binary_dataset.hpp"
+#include "project_exceptions.hpp"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <future>
+#include <type_traits>
+
+template <typename T>
+DataWriter<T>::DataWriter(const std::filesystem::path& path, Eigen::Index rows, Eigen::Index cols,
+                          DataFormat format, int precision, unsigned int threads)
+    : _path(path), _format(format), _precision(precision), _threads(std::max(1u, threads)), _rows(rows), _cols(cols)
+{
+    if (rows < 0 || cols < 0) { throw DataWriterException("Invalid datasize --> negative number of rows or columns!", __func__); }
+
+    this->_file.open(path, format == DataFormat::BINARY ? std::ios::binary : std::ios::out);
+    if (!this->_file.is_open())
+    {
+        throw DataWriterException(std::format("The provided file could not be opened! --> '{}'", path.c_str()), __func__);
+    }
+
+    if (format == DataFormat::BINARY)
+    {
+        BinaryDatasetHeader header = make_binary_dataset_header<T>(rows, cols);
+        this->_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        this->_file.flush();
+        // Preallocate the whole file so every chunk can be written at its place in each column
+        std::filesystem::resize_file(path, sizeof(header) + rows * cols * sizeof(T));
+    }
+    else
+    {
+        const std::string parameters = std::format("# {} {}\n", rows, cols);
+        this->_file.write(parameters.data(), parameters.size());
+    }
+    this->_buffers.resize(this->_threads);
+}
+
+template <typename T>
+DataWriter<T>::~DataWriter()
+{
+    if (this->_file.is_open()) { this->_file.close(); }
+}
+
+template <typename T>
+std::size_t DataWriter<T>::_format_rows(const Eigen::MatrixX<T>& chunk, Eigen::Index first, Eigen::Index last, std::vector<char>& buffer) const
+{
+    // Upper bound of the length of a value (sign, digits, point, exponent & separator)
+    const std::size_t value_width = std::max(64, this->_precision + 32);
+    const std::size_t needed = (last - first) * this->_cols * value_width;
+    if (buffer.size() < needed) { buffer.resize(needed); }
+
+    char* begin = buffer.data();
+    char* end = begin + buffer.size();
+    char* ptr = begin;
+    for (Eigen::Index i = first; i < last; i++)
+    {
+        for (Eigen::Index j = 0; j < this->_cols; j++)
+        {
+            std::to_chars_result result;
+            if constexpr (std::is_integral_v<T>)
+            {
+                result = std::to_chars(ptr, end, chunk(i, j));
+            }
+            else
+            {
+                result = this->_precision < 0 ? std::to_chars(ptr, end, chunk(i, j))
+                                              : std::to_chars(ptr, end, chunk(i, j), std::chars_format::general, this->_precision);
+            }
+            ptr = result.ptr;
+            *ptr++ = (j + 1 < this->_cols) ? ' ' : '\n';
+        }
+    }
+    return ptr - begin;
+}
+
+template <typename T>
+void DataWriter<T>::_write_text(const Eigen::MatrixX<T>& chunk)
+{
+    const Eigen::Index rows = chunk.rows();
+    const Eigen::Index threads = std::clamp<Eigen::Index>(rows / MIN_WRITER_ROWS_PER_THREAD, 1, this->_threads);
+
+    if (threads == 1)
+    {
+        std::size_t size = this->_format_rows(chunk, 0, rows, this->_buffers[0]);
+        this->_file.write(this->_buffers[0].data(), size);
+        return;
+    }
+
+    // Contiguous row ranges formatted in parallel, written back in order
+    std::vector<std::future<std::size_t>> sizes;
+    sizes.reserve(threads);
+    for (Eigen::Index t = 0; t < threads; t++)
+    {
+        Eigen::Index first = rows * t / threads;
+        Eigen::Index last = rows * (t + 1) / threads;
+        sizes.push_back(std::async(std::launch::async, &DataWriter<T>::_format_rows, this,
+                                   std::cref(chunk), first, last, std::ref(this->_buffers[t])));
+    }
+    for (Eigen::Index t = 0; t < threads; t++)
+    {
+        std::size_t size = sizes[t].get();
+        this->_file.write(this->_buffers[t].data(), size);
+    }
+}
+
+template <typename T>
+void DataWriter<T>::_write_binary(const Eigen::MatrixX<T>& chunk)
+{
+    for (Eigen::Index j = 0; j < this->_cols; j++)
+    {
+        std::streamoff offset = sizeof(BinaryDatasetHeader) + (j * this->_rows + this->_written) * sizeof(T);
+        this->_file.seekp(offset);
+        this->_file.write(reinterpret_cast<const char*>(chunk.col(j).data()), chunk.rows() * sizeof(T));
+    }
+}
+
+template <typename T>
+void DataWriter<T>::write_rows(const Eigen::MatrixX<T>& chunk)
+{
+    if (!this->_file.is_open()) { throw DataWriterException("The file was already closed!", __func__); }
+    if (chunk.cols() != this->_cols)
+    {
+        throw DataWriterException(std::format("Invalid chunk --> {} columns instead of {}!", chunk.cols(), this->_cols), __func__);
+    }
+    if (this->_written + chunk.rows() > this->_rows)
+    {
+        throw DataWriterException(std::format("Too many rows --> {} announced!", this->_rows), __func__);
+    }
+
+    if (this->_format == DataFormat::BINARY) { this->_write_binary(chunk); }
+    else { this->_write_text(chunk); }
+
+    if (!this->_file) { throw DataWriterException(std::format("Could not write to '{}'!", this->_path.c_str()), __func__); }
+    this->_written += chunk.rows();
+}
+
+template <typename T>
+void DataWriter<T>::close()
+{
+    if (!this->_file.is_open()) { return; }
+    this->_file.close();
+    if (this->_file.fail()) { throw DataWriterException(std::format("Could not write to '{}'!", this->_path.c_str()), __func__); }
+    if (this->_written != this->_rows)
+    {
+        throw DataWriterException(std::format("Missing rows --> {} written out of {}!", this->_written, this->_rows), __func__);
+    }
+}
+
+template <typename T>
+void DataWriter<T>::write(const std::filesystem::path& path, const Eigen::MatrixX<T>& data,
+                          DataFormat format, int precision, unsigned int threads)
+{
+    DataWriter<T> writer(path, data.rows(), data.cols(), format, precision, threads);
+    writer.write_rows(data);
+    writer.close();
+}
+
+template class DataWriter<long double>;
+template class DataWriter<double>;
+template class DataWriter<float>;
+template class DataWriter<int>;
@@ -1,34 +1,84 @@
 #include "datagen.hpp"
+#include "data_writer.hpp"
+#include <algorithm>
+#include <thread>
 
 template <typename T>
 void datagen<T>::write(const std::filesystem::path path, const Eigen::MatrixX<T> &data) {
-    std::ofstream file(path);
-    file << "# " << data.rows() << " " << data.cols() << std::endl;
-    file << data;
-    file.close();
+    DataWriter<T>::write(path, data, DataFormat::TEXT, -1, std::thread::hardware_concurrency());
 }
 
 template <typename T>
-void datagen<T>::random_data(std::filesystem::path path, int n, int m) {
-    Eigen::MatrixX<T> data = Eigen::MatrixX<T>::Random(n, m);
-    datagen<T>::write(path, data);
+void datagen<T>::random_data(std::filesystem::path path, int n, int m, std::uint64_t seed) {
+    RandomGenerator<T> generator(seed);
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    DataWriter<T> writer(path, n, m, DataFormat::TEXT, -1, threads);
+    Eigen::MatrixX<T> chunk;
+    for (int first = 0; first < n; first += DATAGEN_CHUNK_ROWS) {
+        chunk.resize(std::min(DATAGEN_CHUNK_ROWS, n - first), m);
+        generator.fill(chunk, T(-1), T(1), first, threads);
+        writer.write_rows(chunk);
+    }
+    writer.close();
 }
 
 template <typename T>
 void datagen<T>::polynomial(Eigen::VectorX<T> &data, Eigen::VectorX<T> &x, Eigen::VectorX<T> &coeffs) {
-    int n = data.rows();
-    data = coeffs[0]*Eigen::VectorX<T>::Ones(n);
+    int n = x.rows();
     int deg = coeffs.size();
-    Eigen::VectorX<T> y = Eigen::VectorX<T>::Ones(n);
-    for (int i = 1; i < deg; i++) {
-        y = y.cwiseProduct(x);
-        data = data + (coeffs[i]*y).matrix();
+    // Horner: ((c_n x + c_{n-1}) x + ...) x + c_0, in place
+    data.setConstant(n, deg > 0 ? coeffs[deg-1] : T(0));
+    for (int i = deg-2; i >= 0; i--) {
+        data.array() = data.array()*x.array() + coeffs[i];
+    }
+}
+
+template <typename T>
+void datagen<T>::polynomial(Eigen::VectorX<T> &y, const Eigen::MatrixX<T> &X, const std::vector<Monomial> &terms) {
+    Eigen::Index n = X.rows();
+    Eigen::Index m = X.cols();
+
+    // Highest power needed in every dimension
+    std::vector<int> max_exponent(m, 0);
+    for (const Monomial& term : terms) {
+        if (term.exponents.size() > static_cast<std::size_t>(m)) {
+            throw std::invalid_argument("Monomial has more exponents than the data has dimensions.");
+        }
+        for (std::size_t d = 0; d < term.exponents.size(); d++) {
+            if (term.exponents[d] < 0) { throw std::invalid_argument("Negative monomial exponent."); }
+            max_exponent[d] = std::max(max_exponent[d], term.exponents[d]);
+        }
+    }
+
+    // powers[d].col(e) = x_d^e
+    std::vector<Eigen::MatrixX<T>> powers(m);
+    for (Eigen::Index d = 0; d < m; d++) {
+        powers[d].resize(n, max_exponent[d]+1);
+        powers[d].col(0).setOnes();
+        for (int e = 1; e <= max_exponent[d]; e++) {
+            powers[d].col(e) = powers[d].col(e-1).cwiseProduct(X.col(d));
+        }
+    }
+
+    y.setZero(n);
+    Eigen::VectorX<T> term_values(n);
+    for (const Monomial& term : terms) {
+        term_values.setConstant(term.coeff);
+        for (std::size_t d = 0; d < term.exponents.size(); d++) {
+            if (term.exponents[d] > 0) { term_values.array() *= powers[d].col(term.exponents[d]).array(); }
+        }
+        y += term_values;
     }
 }
 
 template <typename T>
-void datagen<T>::polynomial(Eigen::MatrixX<T> &data, Eigen::VectorX<T> &coeffs, std::vector<std::pair<T, T>> range, datagen<T>::PointGeneration pg) {
-    throw std::invalid_argument("Higher dimensions not yet implemented.");
+void datagen<T>::polynomial(Eigen::MatrixX<T> &data, const std::vector<Monomial> &terms, const PointSpec &spec) {
+    datagen<T>::tabulate(data, spec, [&terms](const Eigen::MatrixX<T>& X, Eigen::VectorX<T>& y) { datagen<T>::polynomial(y, X, terms); });
+}
+
+template <typename T>
+void datagen<T>::polynomial(const std::filesystem::path &path, const std::vector<Monomial> &terms, const PointSpec &spec, DataFormat format) {
+    datagen<T>::stream(path, spec, [&terms](const Eigen::MatrixX<T>& X, Eigen::VectorX<T>& y) { datagen<T>::polynomial(y, X, terms); }, format);
 }
 
 template <typename T>
@@ -69,11 +119,103 @@ void datagen<T>::damped_cosine(Eigen::MatrixX2<T> &data, Eigen::VectorX<T> &para
 }
 
 template <typename T>
-void datagen<T>::generate_points(Eigen::VectorX<T> &x, std::pair<T, T> range, datagen<T>::PointGeneration pg) {
+void datagen<T>::damped_cosine(Eigen::VectorX<T> &y, const Eigen::MatrixX<T> &X, const Eigen::VectorX<T> &params) {
+    T a = params[0];
+    T b = params[1];
+    T c = params[2];
+    Eigen::ArrayX<T> r2 = X.rowwise().squaredNorm().array();
+    y = a*(-b*r2).exp()*(c*r2.sqrt()).cos();
+}
+
+template <typename T>
+void datagen<T>::damped_cosine(Eigen::MatrixX<T> &data, const Eigen::VectorX<T> &params, const PointSpec &spec) {
+    datagen<T>::tabulate(data, spec, [&params](const Eigen::MatrixX<T>& X, Eigen::VectorX<T>& y) { datagen<T>::damped_cosine(y, X, params); });
+}
+
+template <typename T>
+void datagen<T>::damped_cosine(const std::filesystem::path &path, const Eigen::VectorX<T> &params, const PointSpec &spec, DataFormat format) {
+    datagen<T>::stream(path, spec, [&params](const Eigen::MatrixX<T>& X, Eigen::VectorX<T>& y) { datagen<T>::damped_cosine(y, X, params); }, format);
+}
+
+template <typename T>
+Eigen::Index datagen<T>::PointSpec::size() const {
+    if (this->set == PointSet::SCATTERED) {
+        if (this->points.size() != 1) { throw std::invalid_argument("Scattered points need a single total number of points."); }
+        return this->points[0];
+    }
+    if (this->points.size() != this->range.size()) { throw std::invalid_argument("Tensor points need a number of points per dimension."); }
+    Eigen::Index n = 1;
+    for (int points : this->points) { n *= points; }
+    return n;
+}
+
+template <typename T>
+void datagen<T>::generate_points(Eigen::MatrixX<T> &X, const PointSpec &spec, Eigen::Index first_row) {
+    Eigen::Index n = X.rows();
+    Eigen::Index m = spec.range.size();
+    if (first_row < 0 || first_row + n > spec.size()) { throw std::invalid_argument("Rows out of the point set."); }
+    X.resize(n, m);
+
+    if (spec.set == PointSet::SCATTERED) {
+        RandomGenerator<T> generator(spec.seed);
+        for (Eigen::Index d = 0; d < m; d++) {
+            for (Eigen::Index i = 0; i < n; i++) {
+                X(i, d) = generator.uniform(first_row + i, d, spec.range[d].first, spec.range[d].second);
+            }
+        }
+        return;
+    }
+
+    // Tensor grid: the axes are small, the row index is decomposed with dimension 0 varying fastest
+    Eigen::Index stride = 1;
+    for (Eigen::Index d = 0; d < m; d++) {
+        Eigen::VectorX<T> axis(spec.points[d]);
+        datagen<T>::generate_points(axis, spec.range[d], spec.pg, spec.seed + d);
+        for (Eigen::Index i = 0; i < n; i++) {
+            X(i, d) = axis(((first_row + i) / stride) % spec.points[d]);
+        }
+        stride *= spec.points[d];
+    }
+}
+
+template <typename T>
+void datagen<T>::tabulate(Eigen::MatrixX<T> &data, const PointSpec &spec, const Function &f) {
+    Eigen::Index m = spec.range.size();
+    Eigen::MatrixX<T> X(spec.size(), m);
+    datagen<T>::generate_points(X, spec);
+    Eigen::VectorX<T> y;
+    f(X, y);
+    data.resize(X.rows(), m+1);
+    data.leftCols(m) = X;
+    data.col(m) = y;
+}
+
+template <typename T>
+void datagen<T>::stream(const std::filesystem::path &path, const PointSpec &spec, const Function &f, DataFormat format) {
+    Eigen::Index n = spec.size();
+    Eigen::Index m = spec.range.size();
+    DataWriter<T> writer(path, n, m+1, format, -1, std::max(1u, std::thread::hardware_concurrency()));
+    Eigen::MatrixX<T> X;
+    Eigen::VectorX<T> y;
+    Eigen::MatrixX<T> chunk;
+    for (Eigen::Index first = 0; first < n; first += DATAGEN_CHUNK_ROWS) {
+        X.resize(std::min<Eigen::Index>(DATAGEN_CHUNK_ROWS, n - first), m);
+        datagen<T>::generate_points(X, spec, first);
+        f(X, y);
+        chunk.resize(X.rows(), m+1);
+        chunk.leftCols(m) = X;
+        chunk.col(m) = y;
+        writer.write_rows(chunk);
+    }
+    writer.close();
+}
+
+template <typename T>
+void datagen<T>::generate_points(Eigen::VectorX<T> &x, std::pair<T, T> range, datagen<T>::PointGeneration pg, std::uint64_t seed) {
     int n = x.rows();
     switch (pg) {
         case datagen<T>::PointGeneration::RANDOM_UNIFORM:
-            x = Eigen::VectorX<T>::Random(n, 1);
+            RandomGenerator<T>(seed).fill(x, range.first, range.second, 0, std::thread::hardware_concurrency());
             break;
         case datagen<T>::PointGeneration::CHEBYSHEV:
             datagen<T>::chebyshev_points(x, range);
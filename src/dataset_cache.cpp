@@ -0,0 +1,132 @@
+#include "dataset_cache.hpp"
+#include "data_reader.hpp"
+#include "project_exceptions.hpp"
+
+template <typename T>
+DatasetCache<T>::DatasetCache(std::size_t max_bytes)
+    : _max_bytes(max_bytes) {}
+
+template <typename T>
+void DatasetCache<T>::_erase(typename std::unordered_map<std::string, Entry>::iterator it)
+{
+    this->_bytes -= it->second.bytes;
+    this->_lru.erase(it->second.lru);
+    this->_entries.erase(it);
+}
+
+template <typename T>
+void DatasetCache<T>::_evict(const std::string& keep)
+{
+    while (this->_bytes > this->_max_bytes && this->_lru.back() != keep)
+    {
+        this->_erase(this->_entries.find(this->_lru.back()));
+    }
+}
+
+template <typename T>
+DatasetCache<T>::Dataset DatasetCache<T>::get(const std::filesystem::path& path)
+{
+    if (!std::filesystem::exists(path)) { throw DataReaderException::FileNotFound(path.c_str()); }
+
+    const std::string key = std::filesystem::canonical(path).string();
+    const auto mtime = std::filesystem::last_write_time(path);
+    const auto size = std::filesystem::file_size(path);
+
+    std::shared_future<Dataset> cached;
+    std::promise<Dataset> promise;
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto it = this->_entries.find(key);
+        if (it != this->_entries.end() && it->second.mtime == mtime && it->second.size == size)
+        {
+            this->_hits++;
+            this->_lru.splice(this->_lru.begin(), this->_lru, it->second.lru);
+            cached = it->second.data;
+        }
+        else
+        {
+            this->_misses++;
+            if (it != this->_entries.end()) { this->_erase(it); }
+            generation = ++this->_generation;
+            this->_lru.push_front(key);
+            this->_entries[key] = Entry{mtime, size, promise.get_future().share(), generation, 0, this->_lru.begin()};
+        }
+    }
+    // Waits if another thread is still parsing the file
+    if (cached.valid()) { return cached.get(); }
+
+    // Parse outside of the lock so other files can be read concurrently
+    try
+    {
+        Dataset dataset = std::make_shared<const Eigen::MatrixX<T>>(DataReader<T>::read(path));
+        promise.set_value(dataset);
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        // The entry may already have been replaced or evicted by another thread
+        auto it = this->_entries.find(key);
+        if (it != this->_entries.end() && it->second.generation == generation)
+        {
+            it->second.bytes = dataset->size() * sizeof(T);
+            this->_bytes += it->second.bytes;
+            this->_evict(key);
+        }
+        return dataset;
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        auto it = this->_entries.find(key);
+        if (it != this->_entries.end() && it->second.generation == generation) { this->_erase(it); }
+        throw;
+    }
+}
+
+template <typename T>
+void DatasetCache<T>::clear()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_entries.clear();
+    this->_lru.clear();
+    this->_bytes = 0;
+}
+
+template <typename T>
+std::size_t DatasetCache<T>::size() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_entries.size();
+}
+
+template <typename T>
+std::size_t DatasetCache<T>::bytes() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_bytes;
+}
+
+template <typename T>
+std::size_t DatasetCache<T>::hits() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_hits;
+}
+
+template <typename T>
+std::size_t DatasetCache<T>::misses() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_misses;
+}
+
+template <typename T>
+DatasetCache<T>& DatasetCache<T>::global()
+{
+    static DatasetCache<T> cache;
+    return cache;
+}
+
+template class DatasetCache<long double>;
+template class DatasetCache<double>;
+template class DatasetCache<float>;
+template class DatasetCache<int>;
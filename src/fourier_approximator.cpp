@@ -1,28 +1,374 @@
 #include "fourier_approximator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
 
 template <typename T>
-FourierApproximator<T>::FourierApproximator() {
+FourierApproximator<T>::FourierApproximator(T tolerance) {
     if(std::is_same<T, int>::value) {
         throw InterpolationProjectException::InvalidType("FourierApproximator does not support int type!", __func__);
     }
+    this->_tolerance = std::max(tolerance, T(10) * std::numeric_limits<T>::epsilon());
+    // Real-to-complex transforms of the non-negative frequencies only, normalized when resampling
+    this->_fft.SetFlag(Eigen::FFT<T>::HalfSpectrum);
+    this->_fft.SetFlag(Eigen::FFT<T>::Unscaled);
 }
 
 template <typename T>
 void FourierApproximator<T>::fit(const Eigen::VectorX<T> &v) {
-    this->_freq = Eigen::VectorX<std::complex<T>>(v.rows());
-    this->_x_min = v.minCoeff();
-    this->_x_max = v.maxCoeff();
-    this->_fft.fwd(this->_freq, v);
+    this->fit(v, T(0), T(v.rows()));
+}
+
+template <typename T>
+void FourierApproximator<T>::fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx) {
+    if (dim_idx >= X.cols()) {
+        throw InterpolationProjectException::IndexOutOfBounds(dim_idx, X.cols()-1);
+    }
+    if (X.cols() != 2) {
+        throw InterpolationProjectException::MultidimensionalImplementation("FourierApproximator only fits 1D signals!", __func__);
+    }
+    this->fit(X.col(1 - dim_idx), X.col(dim_idx));
+}
+
+template <typename T>
+void FourierApproximator<T>::fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
+    if (X.rows() != y.rows()) {
+        throw InterpolationProjectException::SizeMismatch(y.rows(), X.rows());
+    }
+    if (X.cols() > 1) {
+        throw InterpolationProjectException::MultidimensionalImplementation("FourierApproximator only fits 1D signals!", __func__);
+    }
+    if (X.rows() < 2) {
+        throw InterpolationProjectException("At least 2 samples are needed to get the period of the signal!", __func__);
+    }
+    // The samples must be equispaced, the period ending one step after the last one
+    const Eigen::Index n = X.rows();
+    const T step = (X(n-1, 0) - X(0, 0)) / T(n - 1);
+    const T deviation = (X.col(0).array() - (Eigen::ArrayX<T>::LinSpaced(n, T(0), T(n - 1)) * step + X(0, 0))).abs().maxCoeff();
+    if (!(step > 0) || deviation > std::sqrt(std::numeric_limits<T>::epsilon()) * step * n) {
+        throw InterpolationProjectException("FourierApproximator requires ascending & equispaced samples!", __func__);
+    }
+    this->fit(y, X(0, 0), X(n-1, 0) + step);
+}
+
+template <typename T>
+void FourierApproximator<T>::fit(const Eigen::VectorX<T> &v, T x_min, T x_max) {
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
+    if (v.rows() == 0) {
+        throw InterpolationProjectException("Cannot fit an empty signal!", __func__);
+    }
+    if (!(x_max > x_min)) {
+        throw InterpolationProjectException(std::format("Invalid period [{}, {})!", x_min, x_max), __func__);
+    }
+    this->_n = v.rows();
+    this->_x_min = x_min;
+    this->_x_max = x_max;
+    this->_freq.resize(this->_n / 2 + 1);
+    this->_fft.fwd(this->_freq.data(), v.data(), this->_n);
+
+    // Streaming state: the window starts as the fitted signal, all the bins are tracked
+    this->_window = v;
+    this->_head = 0;
+    this->_x_origin = x_min;
+    this->_step = (x_max - x_min) / T(this->_n);
+    this->_pushed = 0;
+    this->_since_renormalization = 0;
+    this->_twiddles.resize(this->_n / 2 + 1);
+    for (Eigen::Index k = 0; k <= this->_n / 2; k++) {
+        this->_twiddles(k) = std::polar(T(1), 2 * std::numbers::pi_v<T> * T(k) / T(this->_n));
+    }
+    this->_bins.resize(this->_n / 2 + 1);
+    std::iota(this->_bins.begin(), this->_bins.end(), Eigen::Index(0));
+    this->_prepare_grid();
+}
+
+template <typename T>
+void FourierApproximator<T>::push(T sample) {
+    if (this->_n == 0) {
+        throw InterpolationProjectException("The approximator must be fitted first!", __func__);
+    }
+    const T delta = sample - this->_window(this->_head);
+    this->_window(this->_head) = sample;
+    this->_head = (this->_head + 1) % this->_n;
+    for (Eigen::Index k : this->_bins) {
+        this->_freq(k) = (this->_freq(k) + delta) * this->_twiddles(k);
+    }
+
+    // The period moves forward by one step (from the fitted period, without accumulating rounding errors)
+    this->_pushed++;
+    this->_x_min = this->_x_origin + T(this->_pushed) * this->_step;
+    this->_x_max = this->_x_origin + T(this->_pushed + this->_n) * this->_step;
+    this->_grid_stale = true;
+
+    if (++this->_since_renormalization >= std::max<Eigen::Index>(this->_n, SLIDING_DFT_RENORMALIZATION)) {
+        this->renormalize();
+    }
+}
+
+template <typename T>
+void FourierApproximator<T>::push(const Eigen::VectorX<T>& samples) {
+    for (Eigen::Index i = 0; i < samples.rows(); i++) {
+        this->push(samples(i));
+    }
+}
+
+template <typename T>
+void FourierApproximator<T>::track_bins(const std::vector<Eigen::Index>& bins) {
+    if (this->_n == 0) {
+        throw InterpolationProjectException("The approximator must be fitted first!", __func__);
+    }
+    for (Eigen::Index k : bins) {
+        if (k < 0 || k > this->_n / 2) {
+            throw InterpolationProjectException::IndexOutOfBounds(k, this->_n / 2);
+        }
+    }
+    const bool all = bins.empty();
+    this->_bins = bins;
+    if (all) {
+        this->_bins.resize(this->_n / 2 + 1);
+        std::iota(this->_bins.begin(), this->_bins.end(), Eigen::Index(0));
+    }
+    std::sort(this->_bins.begin(), this->_bins.end());
+    this->_bins.erase(std::unique(this->_bins.begin(), this->_bins.end()), this->_bins.end());
+
+    // Untracked bins are zeroed, the tracked ones (possibly stale if untracked before) recomputed
+    Eigen::VectorX<std::complex<T>> tracked = Eigen::VectorX<std::complex<T>>::Zero(this->_freq.size());
+    for (Eigen::Index k : this->_bins) { tracked(k) = this->_freq(k); }
+    this->_freq = tracked;
+    this->renormalize();
+}
+
+template <typename T>
+void FourierApproximator<T>::renormalize() {
+    const Eigen::Index N = this->_n;
+    // Window in chronological order
+    Eigen::VectorX<T> window(N);
+    window.head(N - this->_head) = this->_window.tail(N - this->_head);
+    window.tail(this->_head) = this->_window.head(this->_head);
+
+    const Eigen::Index K = this->_bins.size();
+    if (K == N / 2 + 1) {
+        this->_fft.fwd(this->_freq.data(), window.data(), N);
+    }
+    else {
+        // Direct DFT of the K tracked bins, O(K N) every N samples at least
+        for (Eigen::Index k : this->_bins) {
+            const std::complex<T> twiddle = std::conj(this->_twiddles(k));
+            std::complex<T> phase = 1;
+            std::complex<T> sum = 0;
+            for (Eigen::Index j = 0; j < N; j++, phase *= twiddle) {
+                sum += window(j) * phase;
+            }
+            this->_freq(k) = sum;
+        }
+    }
+    this->_since_renormalization = 0;
+    this->_grid_stale = true;
+}
+
+template <typename T>
+T FourierApproximator<T>::_evaluate_direct(T x) const {
+    const Eigen::Index N = this->_n;
+    const T theta = 2 * std::numbers::pi_v<T> * (x - this->_x_min) / (this->_x_max - this->_x_min);
+    T sum = 0;
+    for (Eigen::Index k : this->_bins) {
+        // Real part of the +k & -k terms, the DC & Nyquist bins appearing once
+        const T weight = (k == 0 || 2 * k == N) ? T(1) : T(2);
+        sum += weight * (this->_freq(k) * std::polar(T(1), T(k) * theta)).real();
+    }
+    return sum / T(N);
+}
+
+template <typename T>
+Eigen::VectorX<T> FourierApproximator<T>::synthesize(const Eigen::MatrixX<T>& X) const {
+    if (X.cols() > 1) {
+        throw InterpolationProjectException::MultidimensionalImplementation("FourierApproximator only evaluates 1D signals!", __func__);
+    }
+    if (this->_n == 0) {
+        throw InterpolationProjectException("The approximator must be fitted first!", __func__);
+    }
+    Eigen::VectorX<T> y(X.rows());
+    for (Eigen::Index i = 0; i < X.rows(); i++) {
+        y(i) = this->_query(X(i, 0), __func__, true);
+    }
+    return y;
+}
+
+template <typename T>
+void FourierApproximator<T>::_prepare_grid() {
+    const Eigen::Index N = this->_n;
+    const Eigen::Index M = NUFFT_OVERSAMPLING * N;
+    const T R = NUFFT_OVERSAMPLING;
+    const T pi = std::numbers::pi_v<T>;
+
+    // About one digit per grid point (Greengard & Lee), the window must fit in the grid
+    this->_spread = std::clamp<int>(std::ceil(-std::log10(this->_tolerance)), 2, NUFFT_MAX_SPREAD);
+    this->_spread = std::min<int>(this->_spread, M / 2);
+    this->_tau = pi * this->_spread / (T(N) * T(N) * R * (R - T(0.5)));
+
+    // Deconvolution by the Fourier coefficients sqrt(tau/pi) exp(-k^2 tau) of the periodic Gaussian,
+    // normalized by 1/N (interpolant) and 1/M (quadrature over the grid)
+    _resample_spectrum(this->_freq, N, N + 1 - N % 2, this->_resampled);
+    this->_spectrum.setZero(M / 2 + 1);
+    for (Eigen::Index k = 0; k <= N / 2; k++) {
+        this->_spectrum(k) = this->_resampled(k) * std::sqrt(pi / this->_tau) * std::exp(T(k * k) * this->_tau) / T(M);
+    }
+    this->_grid.resize(M);
+    this->_fft.inv(this->_grid.data(), this->_spectrum.data(), M);
+    this->_grid_stale = false;
+
+    const T h = 2 * pi / T(M);
+    this->_kernel.resize(this->_spread + 1);
+    for (int j = 0; j <= this->_spread; j++) {
+        this->_kernel(j) = std::exp(-T(j * j) * h * h / (4 * this->_tau));
+    }
+}
+
+template <typename T>
+T FourierApproximator<T>::_evaluate(T x) const {
+    const Eigen::Index M = this->_grid.size();
+    const T pi = std::numbers::pi_v<T>;
+    const T h = 2 * pi / T(M);
+
+    // Angle of x within the period, then position relative to the grid point on its left
+    T theta = 2 * pi * (x - this->_x_min) / (this->_x_max - this->_x_min);
+    theta -= 2 * pi * std::floor(theta / (2 * pi));
+    Eigen::Index l0 = static_cast<Eigen::Index>(theta / h);
+    l0 = std::min<Eigen::Index>(l0, M - 1);
+    const T d0 = theta - T(l0) * h;
+
+    // exp(-(d0 - j h)^2 / 4 tau) = exp(-d0^2 / 4 tau) * exp(d0 h / 2 tau)^j * exp(-(j h)^2 / 4 tau)
+    const T e1 = std::exp(-d0 * d0 / (4 * this->_tau));
+    const T e2 = std::exp(d0 * h / (2 * this->_tau));
+    const T* grid = this->_grid.data();
+    T sum = 0;
+    T power = 1;
+    for (int j = 0; j <= this->_spread; j++, power *= e2) {
+        Eigen::Index l = l0 + j;
+        if (l >= M) { l -= M; }
+        sum += grid[l] * power * this->_kernel(j);
+    }
+    power = 1 / e2;
+    for (int j = 1; j < this->_spread; j++, power /= e2) {
+        Eigen::Index l = l0 - j;
+        if (l < 0) { l += M; }
+        sum += grid[l] * power * this->_kernel(j);
+    }
+    return e1 * sum;
+}
+
+template <typename T>
+T FourierApproximator<T>::_query(T x, const char* where, bool direct) const {
+    if (x >= this->_x_min && x <= this->_x_max) {
+        return direct ? this->_evaluate_direct(x) : this->_evaluate(x);
+    }
+    INTERPOLATION_STATS_ADD(EXTRAPOLATIONS, 1);
+    switch (this->_extrapolation_policy) {
+        case ExtrapolationPolicy::CLAMP:
+            x = std::clamp(x, this->_x_min, this->_x_max);
+            return direct ? this->_evaluate_direct(x) : this->_evaluate(x);
+        case ExtrapolationPolicy::NAN_VALUE:
+            return std::numeric_limits<T>::quiet_NaN();
+        case ExtrapolationPolicy::EXTRAPOLATE:
+            return direct ? this->_evaluate_direct(x) : this->_evaluate(x);
+        case ExtrapolationPolicy::THROW:
+        default:
+            INTERPOLATION_STATS_ADD(EXTRAPOLATION_ERRORS, 1);
+            throw InterpolationProjectException::Extrapolation(x, this->_x_min, this->_x_max, where);
+    }
+}
+
+template <typename T>
+Eigen::VectorX<T> FourierApproximator<T>::operator()(const Eigen::MatrixX<T>& X) {
+    if (X.cols() > 1) {
+        throw InterpolationProjectException::MultidimensionalImplementation("FourierApproximator only evaluates 1D signals!", __func__);
+    }
+    if (this->_n == 0) {
+        throw InterpolationProjectException("The approximator must be fitted first!", __func__);
+    }
+    INTERPOLATION_STATS_ADD(BATCHES, 1);
+    INTERPOLATION_STATS_ADD(BATCH_QUERIES, X.rows());
+    INTERPOLATION_STATS_ADD(QUERIES, X.rows());
+    if (this->_grid_stale) { this->_prepare_grid(); }
+    Eigen::VectorX<T> y(X.rows());
+    for (Eigen::Index i = 0; i < X.rows(); i++) {
+        y(i) = this->_query(X(i, 0), __func__, false);
+    }
+    return y;
+}
+
+template <typename T>
+T FourierApproximator<T>::operator()(T x) {
+    if (this->_n == 0) {
+        throw InterpolationProjectException("The approximator must be fitted first!", __func__);
+    }
+    INTERPOLATION_STATS_ADD(QUERIES, 1);
+    if (this->_grid_stale) { this->_prepare_grid(); }
+    return this->_query(x, __func__, false);
+}
+
+template <typename T>
+void FourierApproximator<T>::_resample_spectrum(const Eigen::VectorX<std::complex<T>>& freq, Eigen::Index N, Eigen::Index n,
+                                                Eigen::VectorX<std::complex<T>>& out) {
+    out.setZero(n / 2 + 1);
+    const Eigen::Index kmax = std::min(n / 2, N / 2);
+    out.head(kmax + 1) = freq.head(kmax + 1) / T(N);
+
+    const bool source_nyquist = N % 2 == 0 && N / 2 <= kmax;
+    const bool target_nyquist = n % 2 == 0 && n / 2 <= kmax;
+    if (source_nyquist && target_nyquist) { return; }
+    // cos(N x / 2) is split between the +N/2 and -N/2 bins of the longer signal
+    if (source_nyquist) { out(N / 2) *= T(0.5); }
+    // +n/2 and -n/2 fold into the real Nyquist bin of the shorter signal
+    if (target_nyquist) { out(n / 2) = T(2) * out(n / 2).real(); }
 }
 
 template <typename T>
 Eigen::VectorX<T> FourierApproximator<T>::approximate_points(int n) {
-    
-    Eigen::FFT<T> fft;
+    if (this->_n == 0) {
+        throw InterpolationProjectException("The approximator must be fitted first!", __func__);
+    }
+    if (n < 1) {
+        throw InterpolationProjectException(std::format("Cannot approximate {} points!", n), __func__);
+    }
     Eigen::VectorX<T> inv(n);
-    fft.inv(inv, this->_freq, n);
+    _resample_spectrum(this->_freq, this->_n, n, this->_resampled);
+    this->_fft.inv(inv.data(), this->_resampled.data(), n);
     return inv;
 }
 
+template <typename T>
+Eigen::VectorX<T> FourierApproximator<T>::sample_points(int n) const {
+    const T step = (this->_x_max - this->_x_min) / n;
+    return (Eigen::ArrayX<T>::LinSpaced(n, T(0), T(n - 1)) * step + this->_x_min).matrix();
+}
+
+template <typename T>
+Eigen::MatrixX<T> FourierApproximator<T>::approximate(int n) {
+    Eigen::MatrixX<T> points(n, 2);
+    points.col(1) = this->approximate_points(n);
+    points.col(0) = this->sample_points(n);
+    return points;
+}
+
+template <typename T>
+Eigen::MatrixX<T> FourierApproximator<T>::resample(const Eigen::MatrixX<T>& signals, int n) {
+    const Eigen::Index N = signals.rows();
+    if (N == 0 || n < 1) {
+        throw InterpolationProjectException(std::format("Cannot resample signals of {} samples to {} points!", N, n), __func__);
+    }
+    Eigen::MatrixX<T> resampled(n, signals.cols());
+    this->_spectrum.resize(N / 2 + 1);
+    for (Eigen::Index j = 0; j < signals.cols(); j++) {
+        this->_fft.fwd(this->_spectrum.data(), signals.col(j).data(), N);
+        _resample_spectrum(this->_spectrum, N, n, this->_resampled);
+        this->_fft.inv(resampled.col(j).data(), this->_resampled.data(), n);
+    }
+    return resampled;
+}
+
+template class FourierApproximator<long double>;
 template class FourierApproximator<double>;
-template class FourierApproximator<float>;
\ No newline at end of file
+template class FourierApproximator<float>;
@@ -0,0 +1,41 @@
+#include "instrumentation.hpp"
+#include <format>
+
+std::string StatsSnapshot::to_string() const
+{
+    const auto ratio = [](double a, double b) { return b > 0 ? a / b : 0.0; };
+    std::string s;
+    s += std::format("fits                 : {} ({:.3f} ms total, {:.3f} us mean)\n", this->fits, this->fit_ns * 1e-6, ratio(this->fit_ns * 1e-3, this->fits));
+    s += std::format("batches              : {} (mean size {:.1f})\n", this->batches, ratio(this->batch_queries, this->batches));
+    s += std::format("queries              : {}\n", this->queries);
+    s += std::format("extrapolations       : {} ({} errors)\n", this->extrapolations, this->extrapolation_errors);
+    s += std::format("exact node hits      : {}\n", this->exact_node_hits);
+    s += std::format("spline bin searches  : {} (mean walk {:.2f} bins)\n", this->bin_searches, ratio(this->bin_walk_steps, this->bin_searches));
+    s += std::format("files read           : {} ({} bytes, {:.1f} MB/s)\n", this->files_read, this->bytes_read, ratio(this->bytes_read * 1e3, this->read_ns));
+    return s;
+}
+
+StatsSnapshot Stats::snapshot()
+{
+    const auto get = [](Counter counter) { return _counters[counter].load(std::memory_order_relaxed); };
+    StatsSnapshot snapshot;
+    snapshot.fits = get(FITS);
+    snapshot.fit_ns = get(FIT_NS);
+    snapshot.batches = get(BATCHES);
+    snapshot.batch_queries = get(BATCH_QUERIES);
+    snapshot.queries = get(QUERIES);
+    snapshot.extrapolations = get(EXTRAPOLATIONS);
+    snapshot.extrapolation_errors = get(EXTRAPOLATION_ERRORS);
+    snapshot.exact_node_hits = get(EXACT_NODE_HITS);
+    snapshot.bin_searches = get(BIN_SEARCHES);
+    snapshot.bin_walk_steps = get(BIN_WALK_STEPS);
+    snapshot.files_read = get(FILES_READ);
+    snapshot.bytes_read = get(BYTES_READ);
+    snapshot.read_ns = get(READ_NS);
+    return snapshot;
+}
+
+void Stats::reset()
+{
+    for (std::atomic<std::uint64_t>& counter : _counters) { counter.store(0, std::memory_order_relaxed); }
+}
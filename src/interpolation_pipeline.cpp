@@ -0,0 +1,120 @@
+#include "interpolation_pipeline.hpp"
+#include "bounded_queue.hpp"
+#include "data_reader.hpp"
+#include "datagen.hpp"
+#include "project_exceptions.hpp"
+#include <chrono>
+#include <format>
+#include <future>
+
+template <typename T>
+InterpolationPipeline<T>::InterpolationPipeline(const std::vector<std::string>& interpolators, const std::vector<std::string>& options,
+                                                Eigen::Index samples, std::size_t capacity)
+    : _interpolators(interpolators), _options(options), _samples(samples), _capacity(capacity) {}
+
+template <typename T>
+PipelineTimings InterpolationPipeline<T>::run(const std::vector<PipelineJob>& jobs) const
+{
+    for (const PipelineJob& job : jobs)
+    {
+        if (job.outputs.size() != this->_interpolators.size())
+        {
+            throw InterpolationProjectException(std::format("Expected one output per interpolator ({}), got {}!", this->_interpolators.size(), job.outputs.size()), __func__);
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    PipelineTimings timings;
+    BoundedQueue<Loaded> loaded(this->_capacity);
+    BoundedQueue<Fitted> fitted(this->_capacity);
+    BoundedQueue<Output> outputs(this->_capacity);
+
+    // A failing stage closes every queue so that the other stages stop instead of waiting forever
+    auto stage = [&](double& busy, auto body) {
+        return std::async(std::launch::async, [&, body] {
+            try
+            {
+                body(busy);
+            }
+            catch (...)
+            {
+                loaded.close();
+                fitted.close();
+                outputs.close();
+                throw;
+            }
+        });
+    };
+    auto elapsed = [](clock::time_point from) { return std::chrono::duration<double>(clock::now() - from).count(); };
+
+    std::future<void> stages[4];
+    stages[0] = stage(timings.read, [&](double& busy) {
+        for (std::size_t j = 0; j < jobs.size(); j++)
+        {
+            const auto t = clock::now();
+            // Not read through the global cache, so that the dataset is freed with its job
+            Dataset data = std::make_shared<const Eigen::MatrixX<T>>(DataReader<T>::read(jobs[j].input));
+            busy += elapsed(t);
+            if (!loaded.push({j, std::move(data)})) { return; }
+        }
+        loaded.close();
+    });
+    stages[1] = stage(timings.fit, [&](double& busy) {
+        while (std::optional<Loaded> item = loaded.pop())
+        {
+            for (std::size_t k = 0; k < this->_interpolators.size(); k++)
+            {
+                const auto t = clock::now();
+                std::unique_ptr<Interpolator<T>> interpolator = DataReader<T>::interpolator_from_data(*item->data, this->_interpolators[k], this->_options, 1);
+                busy += elapsed(t);
+                if (!fitted.push({item->job, k, item->data, std::move(interpolator)})) { return; }
+            }
+        }
+        fitted.close();
+    });
+    stages[2] = stage(timings.evaluate, [&](double& busy) {
+        while (std::optional<Fitted> item = fitted.pop())
+        {
+            const PipelineJob& job = jobs[item->job];
+            // The data copy goes along with the first grid of its job
+            if (item->k == 0 && !job.data_output.empty())
+            {
+                if (!outputs.push({job.data_output, item->data})) { return; }
+            }
+            const auto t = clock::now();
+            const Eigen::MatrixX<T>& X = *item->data;
+            auto grid = std::make_shared<Eigen::MatrixX<T>>(this->_samples, 2);
+            grid->col(0) = Eigen::VectorX<T>::LinSpaced(this->_samples, X.col(0).minCoeff(), X.col(0).maxCoeff());
+            grid->col(1) = (*item->interpolator)(grid->leftCols(1));
+            item->interpolator.reset();
+            busy += elapsed(t);
+            if (!outputs.push({job.outputs[item->k], std::move(grid)})) { return; }
+        }
+        outputs.close();
+    });
+    stages[3] = stage(timings.write, [&](double& busy) {
+        while (std::optional<Output> item = outputs.pop())
+        {
+            const auto t = clock::now();
+            datagen<T>::write(item->path, *item->data);
+            busy += elapsed(t);
+        }
+    });
+
+    // Every stage is waited for before rethrowing the first error
+    std::exception_ptr error;
+    for (std::future<void>& future : stages)
+    {
+        try { future.get(); }
+        catch (...) { if (!error) { error = std::current_exception(); } }
+    }
+    if (error) { std::rethrow_exception(error); }
+    timings.wall = elapsed(start);
+    return timings;
+}
+
+template class InterpolationPipeline<long double>;
+template class InterpolationPipeline<double>;
+template class InterpolationPipeline<float>;
+template class InterpolationPipeline<int>;
@@ -1,5 +1,6 @@
 #include "lagrange_interpolator.hpp"
 #include "project_exceptions.hpp"
+#include "interpolation_kernels.hpp"
 
 template <typename T>
 T LagrangeInterpolator<T>::_lagrange_basis(unsigned int i, const Eigen::VectorX<T>& x_interpolation) 
@@ -7,38 +8,6 @@ T LagrangeInterpolator<T>::_lagrange_basis(unsigned int i, const Eigen::VectorX<
     throw LagrangeInterpolatorException::MultidimensionalImplementation("M dimension interpolation is not yet implemented :/ Please try later!");
 }
 
-template <typename T>
-T LagrangeInterpolator<T>::_lagrange_basis(unsigned int i, T x_interpolation) 
-{
-    Eigen::MatrixX<T> X = this->get_X_data();
-    // Checking for only 1D datapoints in X
-    if (X.cols() > 1)
-    {
-        throw LagrangeInterpolatorException::MultidimensionalImplementation("Impossible to use M-dimensional datapoints with 1D interpolation point. Call appropriate function or check fitted X data!");
-    }
-    // Checking for basis index within range of N datapoints
-    if (i >= X.rows())
-    {
-        throw LagrangeInterpolatorException::IndexOutOfBounds(i, X.rows()-1);
-    }
-    // Calculate i-th basis
-    T li = 1;
-    for (unsigned int j=0; j<X.rows(); j++)
-    {
-        if (j != i)
-        {
-            // Checking for division by 0
-            if (X(i,0) - X(j,0) == 0)
-            {
-                throw LagrangeInterpolatorException::DivisionByZero();
-            }
-            // Calculate the j-th element
-            li *= (x_interpolation - X(j,0)) / (X(i,0) - X(j,0));
-        }
-    }
-    return li;
-};
-
 template <typename T>
 LagrangeInterpolator<T>::LagrangeInterpolator() {}
 
@@ -50,34 +19,38 @@ Eigen::VectorX<T> LagrangeInterpolator<T>::operator()(const Eigen::MatrixX<T>& X
     {
         throw LagrangeInterpolatorException::MultidimensionalImplementation("M dimension interpolation is not yet implemented :/ Please try later!", __func__);
     }
-    else
+    if (this->_X_data.cols() > 1)
     {
-        // Unidimensional case
-        Eigen::VectorX<T> y_out(X.rows());
-        for (unsigned int m=0; m<X.rows(); m++)
-        {
-            // Call the already implemented 1D 1 datapoint operator()
-            y_out(m) = this->operator()(X(m,0));
-        }
-        return y_out;
+        throw LagrangeInterpolatorException::MultidimensionalImplementation("Impossible to use M-dimensional datapoints with 1D interpolation point. Call appropriate function or check fitted X data!");
     }
+    // Unidimensional case, the kernel being inlined in the batch loop (no virtual call per point)
+    const T* nodes = this->_X_data.data();
+    const T* values = this->_y_data.data();
+    const Eigen::Index n = this->_X_data.rows();
+    return this->_evaluate_batch(X.col(0), this->_extrapolation_policy, __func__, [=](T x) { return lagrange_kernel(x, nodes, values, n); });
 }
 
 template <typename T>
 T LagrangeInterpolator<T>::operator()(T x) 
 {
+    INTERPOLATION_STATS_ADD(QUERIES, 1);
     // Check if x within the interpolation range
     if (x > this->_X_max(0) || x < this->_X_min(0))
     {
-        throw InterpolationProjectException::Extrapolation("Should not extrapolate!", __func__);
+        return this->_extrapolate(x, this->_extrapolation_policy, __func__);
     }
-    // Calculate y_m with basis l_i
-    T y_m = 0;
-    for (unsigned int i=0; i<this->get_X_data().rows(); i++)
+    return this->_evaluate(x);
+}
+
+template <typename T>
+T LagrangeInterpolator<T>::_evaluate(T x) 
+{
+    // Checking for only 1D datapoints in X
+    if (this->_X_data.cols() > 1)
     {
-        y_m += this->_lagrange_basis(i, x)*this->get_y_data()(i);
+        throw LagrangeInterpolatorException::MultidimensionalImplementation("Impossible to use M-dimensional datapoints with 1D interpolation point. Call appropriate function or check fitted X data!");
     }
-    return y_m;
+    return lagrange_kernel(x, this->_X_data.data(), this->_y_data.data(), this->_X_data.rows());
 }
 
 template class LagrangeInterpolator<int>;
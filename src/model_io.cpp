@@ -0,0 +1,327 @@
+#include "model_io.hpp"
+#include "interpolation_kernels.hpp"
+#include "project_exceptions.hpp"
+#include <cstring>
+#include <format>
+#include <fstream>
+
+std::uint64_t model_section_count(ModelKind kind, ModelSection section, std::uint64_t n)
+{
+    switch (section)
+    {
+        case RANGE: return 2;
+        case NODES:
+        case VALUES: return n;
+        case EXTRA:
+            if (kind == ModelKind::BARYCENTRIC) { return n; }
+            if (kind == ModelKind::CUBIC_SPLINE) { return 4 * (n - 1); }
+            return 0;
+        case CLAMPED: return kind == ModelKind::CUBIC_SPLINE ? 2 : 0;
+        default: return 0;
+    }
+}
+
+template <typename T>
+void ModelIO<T>::_write(const std::filesystem::path& path, ModelFileHeader header, const Sections& sections)
+{
+    std::memcpy(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic));
+    header.version = MODEL_FILE_VERSION;
+    header.dtype = dataset_type<T>();
+    header.element_size = sizeof(T);
+
+    // Lay the sections out one after the other, each aligned
+    std::uint64_t offset = sizeof(ModelFileHeader);
+    for (int s=0; s<MODEL_SECTIONS; s++)
+    {
+        if (sections[s].second == 0) { header.offsets[s] = 0; continue; }
+        offset = (offset + MODEL_SECTION_ALIGNMENT - 1) / MODEL_SECTION_ALIGNMENT * MODEL_SECTION_ALIGNMENT;
+        header.offsets[s] = offset;
+        offset += sections[s].second * sizeof(T);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) { throw DataWriterException(std::format("Could not open '{}' for writing!", path.string()), __func__); }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const char padding[MODEL_SECTION_ALIGNMENT] = {};
+    for (int s=0; s<MODEL_SECTIONS; s++)
+    {
+        if (sections[s].second == 0) { continue; }
+        file.write(padding, header.offsets[s] - file.tellp());
+        file.write(reinterpret_cast<const char*>(sections[s].first), sections[s].second * sizeof(T));
+    }
+    if (!file) { throw DataWriterException(std::format("Could not write the model to '{}'!", path.string()), __func__); }
+}
+
+template <typename T>
+ModelIO<T>::Sections ModelIO<T>::_polynomial_sections(ModelKind kind, const PolynomialInterpolator<T>& interpolator, std::array<T, 2>& range, ModelFileHeader& header)
+{
+    const Eigen::MatrixX<T>& X = interpolator.get_X_data();
+    const Eigen::VectorX<T>& y = interpolator.get_y_data();
+    if (X.rows() < 2)
+    {
+        throw InterpolationProjectException("Cannot save an interpolator that was not fitted!", __func__);
+    }
+    if (X.cols() > 1)
+    {
+        throw InterpolationProjectException::MultidimensionalImplementation("Only 1D models can be saved!", __func__);
+    }
+    const auto [x_min, x_max] = interpolator.get_range();
+    range = {x_min(0), x_max(0)};
+
+    header = {};
+    header.kind = kind;
+    header.extrapolation_policy = static_cast<std::uint8_t>(interpolator.get_extrapolation_policy());
+    header.summation_mode = static_cast<std::uint8_t>(interpolator.get_summation_mode());
+    header.n = X.rows();
+
+    Sections sections = {};
+    sections[RANGE] = {range.data(), 2};
+    sections[NODES] = {X.data(), header.n};
+    sections[VALUES] = {y.data(), header.n};
+    return sections;
+}
+
+template <typename T>
+void ModelIO<T>::save(const std::filesystem::path& path, const LagrangeInterpolator<T>& interpolator)
+{
+    std::array<T, 2> range;
+    ModelFileHeader header;
+    Sections sections = ModelIO<T>::_polynomial_sections(ModelKind::LAGRANGE, interpolator, range, header);
+    ModelIO<T>::_write(path, header, sections);
+}
+
+template <typename T>
+void ModelIO<T>::save(const std::filesystem::path& path, const BarycentricInterpolator<T>& interpolator)
+{
+    std::array<T, 2> range;
+    ModelFileHeader header;
+    Sections sections = ModelIO<T>::_polynomial_sections(ModelKind::BARYCENTRIC, interpolator, range, header);
+    sections[EXTRA] = {interpolator.get_weights().data(), header.n};
+    ModelIO<T>::_write(path, header, sections);
+}
+
+template <typename T>
+void ModelIO<T>::save(const std::filesystem::path& path, const CubicSplineInterpolator<T>& interpolator)
+{
+    std::array<T, 2> range;
+    ModelFileHeader header;
+    Sections sections = ModelIO<T>::_polynomial_sections(ModelKind::CUBIC_SPLINE, interpolator, range, header);
+    sections[EXTRA] = {interpolator.get_coefficients().data(), 4 * (header.n - 1)};
+    sections[CLAMPED] = {interpolator.get_clamped_values().data(), 2};
+    header.boundary_constraint = static_cast<std::uint8_t>(interpolator.get_boundary_constraint());
+    ModelIO<T>::_write(path, header, sections);
+}
+
+template <typename T>
+void ModelIO<T>::save(const std::filesystem::path& path, const Interpolator<T>& interpolator)
+{
+    if (const auto* lagrange = dynamic_cast<const LagrangeInterpolator<T>*>(&interpolator)) { return save(path, *lagrange); }
+    if (const auto* barycentric = dynamic_cast<const BarycentricInterpolator<T>*>(&interpolator)) { return save(path, *barycentric); }
+    if (const auto* spline = dynamic_cast<const CubicSplineInterpolator<T>*>(&interpolator)) { return save(path, *spline); }
+    throw InterpolationProjectException::InvalidType("Only Lagrange, barycentric & cubic spline interpolators can be saved!", __func__);
+}
+
+template <typename T>
+ModelFileHeader ModelIO<T>::read_header(const std::filesystem::path& path)
+{
+    if (!std::filesystem::exists(path)) { throw DataReaderException::FileNotFound(path.c_str()); }
+    std::ifstream file(path, std::ios::binary);
+    ModelFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (file.gcount() != sizeof(header) || std::memcmp(header.magic, MODEL_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        throw DataReaderException("Not a model file!", __func__);
+    }
+    if (header.version != MODEL_FILE_VERSION)
+    {
+        throw DataReaderException(std::format("Unsupported model file version {}! Expected {}", header.version, MODEL_FILE_VERSION), __func__);
+    }
+    if (header.dtype != dataset_type<T>() || header.element_size != sizeof(T))
+    {
+        throw DataReaderException::InvalidType("Model file type does not match the requested type!", __func__);
+    }
+    if (header.kind > ModelKind::CUBIC_SPLINE || header.n < 2
+        || header.boundary_constraint > CubicSplineInterpolator<T>::CLAMPED
+        || header.extrapolation_policy > static_cast<std::uint8_t>(ExtrapolationPolicy::EXTRAPOLATE)
+        || header.summation_mode > static_cast<std::uint8_t>(SummationMode::COMPENSATED))
+    {
+        throw DataReaderException("Corrupted model file header!", __func__);
+    }
+    // Every present section must be aligned & lie within the file
+    const std::uintmax_t file_size = std::filesystem::file_size(path);
+    for (int s=0; s<MODEL_SECTIONS; s++)
+    {
+        const std::uint64_t count = model_section_count(header.kind, static_cast<ModelSection>(s), header.n);
+        if (count == 0) { continue; }
+        const std::uint64_t offset = header.offsets[s];
+        if (offset < sizeof(header) || offset > file_size || offset % alignof(T) != 0)
+        {
+            throw DataReaderException("Corrupted model file header!", __func__);
+        }
+        // Written as a division so that a huge N cannot wrap around
+        if (count > (file_size - offset) / sizeof(T))
+        {
+            throw DataReaderException("Model file is truncated --> wrong data size!", __func__);
+        }
+    }
+    return header;
+}
+
+template <typename T>
+std::unique_ptr<MappedModel<T>> ModelIO<T>::load(const std::filesystem::path& path)
+{
+    switch (read_header(path).kind)
+    {
+        case ModelKind::LAGRANGE: return std::make_unique<MappedLagrangeInterpolator<T>>(path);
+        case ModelKind::BARYCENTRIC: return std::make_unique<MappedBarycentricInterpolator<T>>(path);
+        case ModelKind::CUBIC_SPLINE:
+        default: return std::make_unique<MappedCubicSplineInterpolator<T>>(path);
+    }
+}
+
+template <typename T>
+MappedModel<T>::MappedModel(const std::filesystem::path& path, ModelKind kind)
+    : _header(ModelIO<T>::read_header(path))
+{
+    if (this->_header.kind != kind)
+    {
+        throw DataReaderException::InvalidType("Model file scheme does not match the requested interpolator!", __func__);
+    }
+    this->_file.open(path.string());
+    this->_extrapolation_policy = static_cast<ExtrapolationPolicy>(this->_header.extrapolation_policy);
+    this->_summation_mode = static_cast<SummationMode>(this->_header.summation_mode);
+    // Only the range is copied (used by the batch range checks)
+    const T* range = this->_section(RANGE);
+    this->_X_min = Eigen::VectorX<T>::Constant(1, range[0]);
+    this->_X_max = Eigen::VectorX<T>::Constant(1, range[1]);
+}
+
+template <typename T>
+const T* MappedModel<T>::_section(ModelSection section) const
+{
+    return reinterpret_cast<const T*>(this->_file.data() + this->_header.offsets[section]);
+}
+
+template <typename T>
+Eigen::Map<const Eigen::VectorX<T>> MappedModel<T>::nodes() const
+{
+    return Eigen::Map<const Eigen::VectorX<T>>(this->_section(NODES), this->size());
+}
+
+template <typename T>
+Eigen::Map<const Eigen::VectorX<T>> MappedModel<T>::values() const
+{
+    return Eigen::Map<const Eigen::VectorX<T>>(this->_section(VALUES), this->size());
+}
+
+template <typename T>
+void MappedModel<T>::fit(const Eigen::MatrixX<T>&, unsigned int)
+{
+    throw InterpolationProjectException("Mapped models are read-only and cannot be refitted!", __func__);
+}
+
+template <typename T>
+void MappedModel<T>::fit(const Eigen::MatrixX<T>&, const Eigen::VectorX<T>&)
+{
+    throw InterpolationProjectException("Mapped models are read-only and cannot be refitted!", __func__);
+}
+
+template <typename T>
+Eigen::VectorX<T> MappedModel<T>::operator()(const Eigen::MatrixX<T>& X)
+{
+    if (X.cols() > 1)
+    {
+        throw InterpolationProjectException::MultidimensionalImplementation("Mapped models only support 1D queries!", __func__);
+    }
+    return this->_evaluate_batch(X.col(0), this->_extrapolation_policy, __func__);
+}
+
+template <typename T>
+T MappedModel<T>::operator()(T x)
+{
+    INTERPOLATION_STATS_ADD(QUERIES, 1);
+    if (x < this->_X_min(0) || x > this->_X_max(0))
+    {
+        return this->_extrapolate(x, this->_extrapolation_policy, __func__);
+    }
+    return this->_evaluate(x);
+}
+
+template <typename T>
+MappedLagrangeInterpolator<T>::MappedLagrangeInterpolator(const std::filesystem::path& path)
+    : MappedModel<T>(path, ModelKind::LAGRANGE) {}
+
+template <typename T>
+T MappedLagrangeInterpolator<T>::_evaluate(T x)
+{
+    return lagrange_kernel(x, this->_section(NODES), this->_section(VALUES), this->size());
+}
+
+template <typename T>
+MappedBarycentricInterpolator<T>::MappedBarycentricInterpolator(const std::filesystem::path& path)
+    : MappedModel<T>(path, ModelKind::BARYCENTRIC) {}
+
+template <typename T>
+T MappedBarycentricInterpolator<T>::_evaluate(T x)
+{
+    if (this->_summation_mode == SummationMode::COMPENSATED)
+    {
+        return barycentric_kernel_compensated(x, this->_section(NODES), this->_section(VALUES), this->_section(EXTRA), this->size());
+    }
+    return barycentric_kernel(x, this->_section(NODES), this->_section(VALUES), this->_section(EXTRA), this->size());
+}
+
+template <typename T>
+Eigen::Map<const Eigen::VectorX<T>> MappedBarycentricInterpolator<T>::weights() const
+{
+    return Eigen::Map<const Eigen::VectorX<T>>(this->_section(EXTRA), this->size());
+}
+
+template <typename T>
+MappedCubicSplineInterpolator<T>::MappedCubicSplineInterpolator(const std::filesystem::path& path)
+    : MappedModel<T>(path, ModelKind::CUBIC_SPLINE) {}
+
+template <typename T>
+T MappedCubicSplineInterpolator<T>::_evaluate(T x)
+{
+    if (this->_summation_mode == SummationMode::COMPENSATED)
+    {
+        return spline_kernel_compensated(x, this->_section(NODES), this->_section(EXTRA), this->size(), this->_X_min(0), this->_X_max(0));
+    }
+    return spline_kernel(x, this->_section(NODES), this->_section(EXTRA), this->size(), this->_X_min(0), this->_X_max(0));
+}
+
+template <typename T>
+Eigen::Map<const Eigen::MatrixX4<T>> MappedCubicSplineInterpolator<T>::coefficients() const
+{
+    return Eigen::Map<const Eigen::MatrixX4<T>>(this->_section(EXTRA), this->size() - 1, 4);
+}
+
+template <typename T>
+typename CubicSplineInterpolator<T>::BoundaryConstraint MappedCubicSplineInterpolator<T>::boundary_constraint() const
+{
+    return static_cast<typename CubicSplineInterpolator<T>::BoundaryConstraint>(this->_header.boundary_constraint);
+}
+
+template <typename T>
+Eigen::Vector2<T> MappedCubicSplineInterpolator<T>::clamped_values() const
+{
+    const T* clamped = this->_section(CLAMPED);
+    return Eigen::Vector2<T>(clamped[0], clamped[1]);
+}
+
+template class ModelIO<float>;
+template class ModelIO<double>;
+template class ModelIO<long double>;
+template class MappedModel<float>;
+template class MappedModel<double>;
+template class MappedModel<long double>;
+template class MappedLagrangeInterpolator<float>;
+template class MappedLagrangeInterpolator<double>;
+template class MappedLagrangeInterpolator<long double>;
+template class MappedBarycentricInterpolator<float>;
+template class MappedBarycentricInterpolator<double>;
+template class MappedBarycentricInterpolator<long double>;
+template class MappedCubicSplineInterpolator<float>;
+template class MappedCubicSplineInterpolator<double>;
+template class MappedCubicSplineInterpolator<long double>;
@@ -3,6 +3,9 @@
 template <typename T>
 Plotter<T>::Plotter() {}
 
+template <typename T>
+Plotter<T>::Plotter(const std::string& command) : gp(command) {}
+
 template <typename T>
 Plotter<T>::~Plotter() {
     this->gp << "exit\n";
@@ -42,7 +45,7 @@ template <typename T>
 void Plotter<T>::plot(int n, std::filesystem::path* paths, std::string* titles, std::string* styles) {
     this->gp << "plot ";
     for (int i = 0; i < n; i++) {
-        this->gp << std::format("'{}' with {} title '{}', ", (std::string) paths[i], styles[i], titles[i]);
+        this->gp << std::format("{}'{}' with {} title '{}'", i > 0 ? ", " : "", (std::string) paths[i], styles[i], titles[i]);
     }
     this->gp << "\n";
 }
@@ -1,64 +1,112 @@
 #include "polynomial_interpolator.hpp"
 #include "project_exceptions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
-template <typename T>
-void PolynomialInterpolator<T>::fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx)
+template <typename T, typename S>
+void PolynomialInterpolator<T, S>::fit(const Eigen::MatrixX<T>& X, unsigned int dim_idx)
 {
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
     // Check index limits
     if (dim_idx >= X.cols()) 
     {
         throw PolynomialInterpolatorException::IndexOutOfBounds(dim_idx, X.cols()-1);
     }
-    this->_X_data = Eigen::MatrixX<T>(X.rows(), X.cols()-1);
-    this->_X_data << X.leftCols(dim_idx), X.rightCols(X.cols()-dim_idx-1);
-    this->_y_data = X.col(dim_idx);
+    this->_X_data.resize(X.rows(), X.cols()-1);
+    this->_X_data << X.leftCols(dim_idx).template cast<S>(), X.rightCols(X.cols()-dim_idx-1).template cast<S>();
+    this->_y_data = X.col(dim_idx).template cast<S>();
 
     // Update data range
     this->_calculate_range();
 }
 
-template <typename T>
-void PolynomialInterpolator<T>::fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y)
+template <typename T, typename S>
+void PolynomialInterpolator<T, S>::fit(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y)
 {
+    INTERPOLATION_STATS_SCOPE(FITS, FIT_NS);
     // Check if # rows in X matches number of rows in y (=> # datapoints)
     if (X.rows() != y.rows())
     {
         throw PolynomialInterpolatorException::SizeMismatch(y.rows(), X.rows());
     }
-    this->_X_data = X;
-    this->_y_data = y;
+    this->_X_data = X.template cast<S>();
+    this->_y_data = y.template cast<S>();
 
     // Update data range
     this->_calculate_range();
 }
 
-template <typename T>
-void PolynomialInterpolator<T>::_calculate_range()
+template <typename T, typename S>
+void PolynomialInterpolator<T, S>::_calculate_range()
 {
-    this->_X_max = Eigen::VectorX<T>(this->_X_data.cols());
-    this->_X_min = Eigen::VectorX<T>(this->_X_data.cols());
+    // No reallocation when refitting the same dimension
+    this->_X_max.resize(this->_X_data.cols());
+    this->_X_min.resize(this->_X_data.cols());
     for (unsigned int i=0; i<this->_X_data.cols(); i++)
     {
-        this->_X_max(i) = this->_X_data.col(i).maxCoeff();
-        this->_X_min(i) = this->_X_data.col(i).minCoeff();
+        this->_X_max(i) = T(this->_X_data.col(i).maxCoeff());
+        this->_X_min(i) = T(this->_X_data.col(i).minCoeff());
+        // Widened by one ulp of the storage so that the range still contains the datapoints given in T
+        if constexpr (!std::is_same_v<S, T>)
+        {
+            this->_X_max(i) = T(std::nextafter(S(this->_X_max(i)), std::numeric_limits<S>::infinity()));
+            this->_X_min(i) = T(std::nextafter(S(this->_X_min(i)), -std::numeric_limits<S>::infinity()));
+        }
     }
 }
 
+template <typename T, typename S>
+T PolynomialInterpolator<T, S>::_extrapolate(T x, ExtrapolationPolicy policy, const char* where)
+{
+    INTERPOLATION_STATS_ADD(EXTRAPOLATIONS, 1);
+    switch (policy)
+    {
+        case ExtrapolationPolicy::CLAMP:
+            return this->_evaluate(std::clamp(x, this->_X_min(0), this->_X_max(0)));
+        case ExtrapolationPolicy::NAN_VALUE:
+            return std::numeric_limits<T>::quiet_NaN();
+        case ExtrapolationPolicy::EXTRAPOLATE:
+            return this->_evaluate(x);
+        case ExtrapolationPolicy::THROW:
+        default:
+            INTERPOLATION_STATS_ADD(EXTRAPOLATION_ERRORS, 1);
+            throw InterpolationProjectException::Extrapolation(x, this->_X_min(0), this->_X_max(0), where);
+    }
+}
+
+template <typename T, typename S>
+Eigen::VectorX<T> PolynomialInterpolator<T, S>::_evaluate_batch(const Eigen::Ref<const Eigen::VectorX<T>>& x, ExtrapolationPolicy policy, const char* where)
+{
+    return this->_evaluate_batch(x, policy, where, [this](T xi) { return this->_evaluate(xi); });
+}
+
+template <typename T, typename S>
+Eigen::VectorX<T> PolynomialInterpolator<T, S>::evaluate(const Eigen::MatrixX<T>& X, ExtrapolationPolicy policy)
+{
+    if (X.cols() > 1)
+    {
+        throw PolynomialInterpolatorException::MultidimensionalImplementation("M dimension interpolation is not yet implemented :/ Please try later!", __func__);
+    }
+    return this->_evaluate_batch(X.col(0), policy, __func__);
+}
+
 /* GETTERS */
-template <typename T>
-const Eigen::MatrixX<T>& PolynomialInterpolator<T>::get_X_data() const 
+template <typename T, typename S>
+const Eigen::MatrixX<S>& PolynomialInterpolator<T, S>::get_X_data() const 
 {
     return this->_X_data;
 }
 
-template <typename T>
-const Eigen::VectorX<T>& PolynomialInterpolator<T>::get_y_data() const 
+template <typename T, typename S>
+const Eigen::VectorX<S>& PolynomialInterpolator<T, S>::get_y_data() const 
 {
     return this->_y_data;
 }
 
-template <typename T>
-std::pair<Eigen::VectorX<T>, Eigen::VectorX<T>> PolynomialInterpolator<T>::get_range() const
+template <typename T, typename S>
+std::pair<Eigen::VectorX<T>, Eigen::VectorX<T>> PolynomialInterpolator<T, S>::get_range() const
 {
     return std::make_pair(this->_X_min, this->_X_max);
 }
@@ -67,3 +115,4 @@ template class PolynomialInterpolator<int>;
 template class PolynomialInterpolator<float>;
 template class PolynomialInterpolator<double>;
 template class PolynomialInterpolator<long double>;
+template class PolynomialInterpolator<double, float>;
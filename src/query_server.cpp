@@ -0,0 +1,309 @@
+#include "query_server.hpp"
+#include "project_exceptions.hpp"
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <set>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+int LatencyHistogram::_bucket(std::uint64_t ns)
+{
+    if (ns < 4) { return ns * LATENCY_BUCKETS_PER_OCTAVE / 4; }
+    // Octave of the leading bit, sub-bucket from the 2 bits below it
+    const int octave = std::bit_width(ns) - 1;
+    const int sub = (ns >> (octave - 2)) & 3;
+    return octave * LATENCY_BUCKETS_PER_OCTAVE + sub;
+}
+
+std::uint64_t LatencyHistogram::_upper_bound(int bucket)
+{
+    const int octave = bucket / LATENCY_BUCKETS_PER_OCTAVE;
+    const int sub = bucket % LATENCY_BUCKETS_PER_OCTAVE;
+    if (octave < 2) { return sub + 1; }
+    return (std::uint64_t(1) << octave) + (std::uint64_t(sub + 1) << (octave - 2)) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t ns)
+{
+    this->_buckets[_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+    this->_count.fetch_add(1, std::memory_order_relaxed);
+    this->_total_ns.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t max = this->_max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !this->_max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const
+{
+    const std::uint64_t count = this->count();
+    if (count == 0) { return 0; }
+    const std::uint64_t target = std::max<std::uint64_t>(1, std::ceil(p / 100.0 * count));
+    std::uint64_t cumulated = 0;
+    for (int b=0; b<BUCKETS; b++)
+    {
+        cumulated += this->_buckets[b].load(std::memory_order_relaxed);
+        if (cumulated >= target) { return std::min(_upper_bound(b), this->_max_ns.load(std::memory_order_relaxed)); }
+    }
+    return this->_max_ns.load(std::memory_order_relaxed);
+}
+
+std::string LatencyHistogram::to_string() const
+{
+    const std::uint64_t count = this->count();
+    const double mean = count > 0 ? double(this->_total_ns.load(std::memory_order_relaxed)) / count : 0.0;
+    return std::format("requests: {} | latency (us) mean {:.1f} p50 {:.1f} p90 {:.1f} p99 {:.1f} max {:.1f}\n",
+                       count, mean * 1e-3, this->percentile(50) * 1e-3, this->percentile(90) * 1e-3,
+                       this->percentile(99) * 1e-3, this->_max_ns.load(std::memory_order_relaxed) * 1e-3);
+}
+
+/**
+ * @brief Client connection, the requests in flight keep it alive until their response is written
+ */
+template <typename T>
+struct QueryServer<T>::Connection {
+    int in_fd;
+    int out_fd;
+    std::mutex write_mutex;
+    std::mutex pending_mutex;
+    std::condition_variable done;
+    std::size_t pending = 0;
+    std::size_t pending_bytes = 0;
+
+    Connection(int in, int out) : in_fd(in), out_fd(out) {}
+};
+
+template <typename T>
+QueryServer<T>::QueryServer(std::size_t workers, std::size_t max_pending_bytes)
+    : _pool(workers), _max_pending_bytes(max_pending_bytes) {}
+
+template <typename T>
+void QueryServer<T>::add_model(const std::string& name, std::shared_ptr<Interpolator<T>> model)
+{
+    if (name.empty() || name.size() > QUERY_SERVER_MAX_NAME)
+    {
+        throw QueryServerException(std::format("Model names must have between 1 and {} characters!", QUERY_SERVER_MAX_NAME), __func__);
+    }
+    this->_models[name] = std::move(model);
+}
+
+template <typename T>
+bool QueryServer<T>::_read_exact(int fd, void* data, std::size_t size)
+{
+    char* bytes = static_cast<char*>(data);
+    while (size > 0)
+    {
+        const ssize_t n = ::read(fd, bytes, size);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0) { return false; }
+        bytes += n;
+        size -= n;
+    }
+    return true;
+}
+
+template <typename T>
+bool QueryServer<T>::_write_all(int fd, const void* data, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        const ssize_t n = ::write(fd, bytes, size);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0) { return false; }
+        bytes += n;
+        size -= n;
+    }
+    return true;
+}
+
+template <typename T>
+void QueryServer<T>::_respond(Connection& connection, QueryResponseHeader header, const void* payload, std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(connection.write_mutex);
+    if (_write_all(connection.out_fd, &header, sizeof(header)) && size > 0)
+    {
+        _write_all(connection.out_fd, payload, size);
+    }
+}
+
+template <typename T>
+void QueryServer<T>::_process(Connection& connection, const QueryRequestHeader& header, const std::string& name,
+                              const Eigen::MatrixX<T>& values, std::chrono::steady_clock::time_point start)
+{
+    QueryResponseHeader response = {};
+    response.id = header.id;
+    response.status = QueryStatus::OK;
+    Eigen::VectorX<T> y;
+    std::string message;
+
+    if (header.op == QueryOp::STATS)
+    {
+        message = this->_latency.to_string();
+    }
+    else if (header.op != QueryOp::EVALUATE)
+    {
+        response.status = QueryStatus::BAD_REQUEST;
+        message = std::format("Unknown operation {}!", static_cast<int>(header.op));
+    }
+    else if (auto model = this->_models.find(name); model == this->_models.end())
+    {
+        response.status = QueryStatus::UNKNOWN_MODEL;
+        message = std::format("Unknown model '{}'!", name);
+    }
+    else
+    {
+        try
+        {
+            y = (*model->second)(values);
+        }
+        catch (const std::exception& e)
+        {
+            response.status = QueryStatus::EVALUATION_ERROR;
+            message = e.what();
+        }
+    }
+
+    const bool values_payload = response.status == QueryStatus::OK && header.op == QueryOp::EVALUATE;
+    response.count = values_payload ? y.size() : message.size();
+    response.latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    this->_latency.record(response.latency_ns);
+    if (values_payload) { this->_respond(connection, response, y.data(), y.size() * sizeof(T)); }
+    else { this->_respond(connection, response, message.data(), message.size()); }
+}
+
+template <typename T>
+void QueryServer<T>::_serve_connection(const std::shared_ptr<Connection>& connection)
+{
+    // Releases a pending request once its task is destroyed, whether it returned, threw or was never run
+    struct PendingRequest {
+        std::shared_ptr<Connection> connection;
+        std::size_t bytes;
+        ~PendingRequest()
+        {
+            std::lock_guard<std::mutex> lock(connection->pending_mutex);
+            connection->pending--;
+            connection->pending_bytes -= bytes;
+            connection->done.notify_all();
+        }
+    };
+
+    QueryRequestHeader header;
+    while (_read_exact(connection->in_fd, &header, sizeof(header)))
+    {
+        const auto start = std::chrono::steady_clock::now();
+        // The payload size is unknown if the header is invalid, the connection can't be resynchronized
+        if (header.count > QUERY_SERVER_MAX_POINTS || (header.op == QueryOp::STATS && header.count > 0))
+        {
+            const std::string message = std::format("Invalid request of {} points, closing the connection!", header.count);
+            QueryResponseHeader response = {header.id, QueryStatus::BAD_REQUEST, {}, message.size(), 0};
+            this->_respond(*connection, response, message.data(), message.size());
+            break;
+        }
+        // Backpressure: the payload is only read once the requests in flight leave room for it
+        const std::size_t bytes = header.name_length + header.count * sizeof(T);
+        {
+            std::unique_lock<std::mutex> lock(connection->pending_mutex);
+            connection->done.wait(lock, [this, &connection, bytes] {
+                return connection->pending == 0 || connection->pending_bytes + bytes <= this->_max_pending_bytes;
+            });
+        }
+        std::string name(header.name_length, '\0');
+        Eigen::MatrixX<T> values(header.count, 1);
+        if (!_read_exact(connection->in_fd, name.data(), name.size()) ||
+            !_read_exact(connection->in_fd, values.data(), values.size() * sizeof(T)))
+        {
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(connection->pending_mutex);
+            connection->pending++;
+            connection->pending_bytes += bytes;
+        }
+        auto request = std::make_shared<PendingRequest>(connection, bytes);
+        this->_pool.submit([this, request, header, name = std::move(name), values = std::move(values), start] {
+            this->_process(*request->connection, header, name, values, start);
+        });
+    }
+
+    // Wait for the responses of the requests in flight
+    std::unique_lock<std::mutex> lock(connection->pending_mutex);
+    connection->done.wait(lock, [&connection] { return connection->pending == 0; });
+}
+
+template <typename T>
+void QueryServer<T>::serve(int in_fd, int out_fd)
+{
+    this->_serve_connection(std::make_shared<Connection>(in_fd, out_fd));
+}
+
+template <typename T>
+void QueryServer<T>::serve_socket(const std::filesystem::path& path)
+{
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.string().size() >= sizeof(address.sun_path))
+    {
+        throw QueryServerException(std::format("Socket path '{}' is too long!", path.string()), __func__);
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) { throw QueryServerException(std::format("Could not create a socket: {}", std::strerror(errno)), __func__); }
+    std::filesystem::remove(path);
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listen_fd, SOMAXCONN) < 0)
+    {
+        const std::string error = std::strerror(errno);
+        ::close(listen_fd);
+        throw QueryServerException(std::format("Could not listen on '{}': {}", path.string(), error), __func__);
+    }
+    this->_listen_fd = listen_fd;
+
+    // Every client is read by its own (detached) thread, the evaluation happens on the pool
+    std::mutex clients_mutex;
+    std::condition_variable clients_done;
+    std::set<int> clients;
+    while (!this->_stopping)
+    {
+        const int client = ::accept(listen_fd, nullptr, nullptr);
+        if (client < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) { continue; }
+            break;
+        }
+        std::lock_guard<std::mutex> lock(clients_mutex);
+        clients.insert(client);
+        std::thread([this, client, &clients_mutex, &clients_done, &clients] {
+            this->_serve_connection(std::make_shared<Connection>(client, client));
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            ::close(client);
+            clients.erase(client);
+            clients_done.notify_all();
+        }).detach();
+    }
+
+    // Stop reading new requests, the ones in flight are still answered
+    std::unique_lock<std::mutex> lock(clients_mutex);
+    for (int client : clients) { ::shutdown(client, SHUT_RD); }
+    clients_done.wait(lock, [&clients] { return clients.empty(); });
+    this->_listen_fd = -1;
+    ::close(listen_fd);
+    std::filesystem::remove(path);
+}
+
+template <typename T>
+void QueryServer<T>::stop()
+{
+    this->_stopping = true;
+    const int listen_fd = this->_listen_fd.load();
+    if (listen_fd >= 0) { ::shutdown(listen_fd, SHUT_RDWR); }
+}
+
+template class QueryServer<float>;
+template class QueryServer<double>;
+template class QueryServer<long double>;
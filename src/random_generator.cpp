@@ -0,0 +1,60 @@
+#include "random_generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+T RandomGenerator<T>::uniform(std::uint64_t row, std::uint64_t col, T low, T high) const
+{
+    const Philox4x32::Counter bits = Philox4x32::generate(
+        {static_cast<std::uint32_t>(row), static_cast<std::uint32_t>(row >> 32), static_cast<std::uint32_t>(col), 0}, this->_key);
+    const std::uint64_t word = (static_cast<std::uint64_t>(bits[0]) << 32) | bits[1];
+
+    if constexpr (std::is_integral_v<T>)
+    {
+        // Bias is at most (high-low+1)/2^64, negligible for the generated ranges
+        const std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+        return static_cast<T>(low + static_cast<std::int64_t>(word % span));
+    }
+    else
+    {
+        // Keep as many random bits as the mantissa holds, so the result stays in [0, 1)
+        constexpr int digits = std::min(std::numeric_limits<T>::digits, 64);
+        const T unit = std::ldexp(static_cast<T>(word >> (64 - digits)), -digits);
+        const T value = low + (high - low) * unit;
+        // Rounding of the affine map could reach high
+        return value < high ? value : low;
+    }
+}
+
+template <typename T>
+void RandomGenerator<T>::fill(Eigen::Ref<Eigen::MatrixX<T>> data, T low, T high, std::uint64_t first_row, unsigned int threads) const
+{
+    const Eigen::Index rows = data.rows();
+    const Eigen::Index n_threads = std::clamp<Eigen::Index>(rows / MIN_RANDOM_ROWS_PER_THREAD, 1, std::max<unsigned int>(threads, 1));
+
+    auto fill_rows = [&](Eigen::Index begin, Eigen::Index end) {
+        for (Eigen::Index j = 0; j < data.cols(); j++)
+        {
+            for (Eigen::Index i = begin; i < end; i++) { data(i, j) = this->uniform(first_row + i, j, low, high); }
+        }
+    };
+
+    if (n_threads == 1) { fill_rows(0, rows); return; }
+
+    std::vector<std::thread> workers;
+    workers.reserve(n_threads);
+    for (Eigen::Index t = 0; t < n_threads; t++)
+    {
+        workers.emplace_back(fill_rows, rows * t / n_threads, rows * (t + 1) / n_threads);
+    }
+    for (std::thread& worker : workers) { worker.join(); }
+}
+
+template class RandomGenerator<long double>;
+template class RandomGenerator<double>;
+template class RandomGenerator<float>;
+template class RandomGenerator<int>;
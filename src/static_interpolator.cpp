@@ -0,0 +1,31 @@
+#include "static_interpolator.hpp"
+
+template <typename T>
+StaticInterpolator<T>::StaticInterpolator(Interpolator<T>& interpolator) : _interpolator(&interpolator)
+{
+    if (auto* lagrange = dynamic_cast<LagrangeInterpolator<T>*>(&interpolator)) { this->_interpolator = lagrange; }
+    else if (auto* barycentric = dynamic_cast<BarycentricInterpolator<T>*>(&interpolator)) { this->_interpolator = barycentric; }
+    else if (auto* spline = dynamic_cast<CubicSplineInterpolator<T>*>(&interpolator)) { this->_interpolator = spline; }
+    else if (auto* fourier = dynamic_cast<FourierApproximator<T>*>(&interpolator)) { this->_interpolator = fourier; }
+}
+
+template <typename T>
+Eigen::VectorX<T> StaticInterpolator<T>::operator()(const Eigen::MatrixX<T>& X) const
+{
+    return this->visit([&](auto& interpolator) {
+        using Concrete = std::decay_t<decltype(interpolator)>;
+        if constexpr (std::is_same_v<Concrete, Interpolator<T>>)
+        {
+            return interpolator(X);
+        }
+        else
+        {
+            // Qualified call, no virtual dispatch
+            return interpolator.Concrete::operator()(X);
+        }
+    });
+}
+
+template class StaticInterpolator<long double>;
+template class StaticInterpolator<double>;
+template class StaticInterpolator<float>;
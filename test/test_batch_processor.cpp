@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <atomic>
+#include <fstream>
+#include "barycentric_interpolator.hpp"
+#include "batch_processor.hpp"
+#include "binary_dataset.hpp"
+#include "data_reader.hpp"
+#include "datagen.hpp"
+#include "project_exceptions.hpp"
+#include "work_stealing_pool.hpp"
+
+/**
+ * @brief Runs the work stealing pool & a batch over a temporary data directory
+ *
+ */
+class BatchProcessorTest: public ::testing::Test {
+    protected:
+        std::filesystem::path dir, output_dir;
+        Eigen::MatrixXd data;
+
+        void SetUp() override {
+            dir = std::filesystem::temp_directory_path() / "test_batch_processor";
+            output_dir = std::filesystem::temp_directory_path() / "test_batch_processor_output";
+            std::filesystem::remove_all(dir);
+            std::filesystem::remove_all(output_dir);
+            std::filesystem::create_directories(dir / "sub");
+            data.resize(12, 2);
+            data.col(0) = Eigen::VectorXd::LinSpaced(12, 0.0, 2.0);
+            data.col(1) = data.col(0).array().cos();
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(dir);
+            std::filesystem::remove_all(output_dir);
+        }
+
+        void WorkStealingPoolRunsNestedTasks()
+        {
+            std::atomic<int> count = 0;
+            {
+                WorkStealingPool pool(3);
+                for (int i=0; i<100; i++)
+                {
+                    pool.submit([&pool, &count] {
+                        count++;
+                        // Tasks submitted by a worker go to its own deque
+                        for (int j=0; j<10; j++) { pool.submit([&count] { count++; }); }
+                    });
+                }
+                pool.wait();
+                EXPECT_EQ(count, 1100);
+                pool.submit([&count] { count++; });
+            }
+            // The destructor runs the remaining tasks
+            EXPECT_EQ(count, 1101);
+        }
+
+        void Run()
+        {
+            datagen<double>::write(dir / "a.txt", data);
+            Eigen::MatrixXd scaled = data;
+            scaled.col(1) *= 2.0;
+            BinaryDataset<double>::write(dir / "sub" / "b.bin", scaled);
+            std::ofstream(dir / "sub" / "broken.txt") << "# 3 2\n0.0 1.0\nnot a number\n";
+            std::ofstream(dir / ".hidden") << "ignored";
+
+            BatchProcessor<double> batch({"barycentric", "cubic_spline"}, {"natural"}, 50, 2);
+            BatchSummary summary = batch.run(dir, output_dir);
+            EXPECT_EQ(summary.files, 3);
+            EXPECT_EQ(summary.failed, 1);
+            EXPECT_EQ(summary.datapoints, 24);
+            EXPECT_EQ(summary.evaluations, 2 * 50 * 2);
+            ASSERT_EQ(summary.errors.size(), 1);
+            EXPECT_NE(summary.errors[0].find("broken.txt"), std::string::npos);
+            EXPECT_NE(summary.to_string().find("files: 3 (1 failed)"), std::string::npos);
+
+            // x y_barycentric y_spline rows, matching a direct fit
+            const std::filesystem::path output = BatchProcessor<double>::output_path(dir / "a.txt", dir, output_dir);
+            EXPECT_EQ(output, output_dir / "a.txt");
+            Eigen::MatrixXd results = DataReader<double>::read(output);
+            ASSERT_EQ(results.rows(), 50);
+            ASSERT_EQ(results.cols(), 3);
+            BarycentricInterpolator<double> barycentric;
+            barycentric.fit(data.col(0), data.col(1));
+            EXPECT_TRUE(results.col(1).isApprox(barycentric(results.leftCols(1))));
+            EXPECT_TRUE(std::filesystem::exists(output_dir / "sub" / "b.txt"));
+        }
+
+        void SharedOutputs()
+        {
+            // a.txt & a.bin would both be written to a.txt
+            datagen<double>::write(dir / "a.txt", data);
+            BinaryDataset<double>::write(dir / "a.bin", data);
+            datagen<double>::write(dir / "c.txt", data);
+
+            BatchProcessor<double> batch({"barycentric"}, {}, 20, 2);
+            BatchSummary summary = batch.run(dir, output_dir);
+            EXPECT_EQ(summary.files, 3);
+            EXPECT_EQ(summary.failed, 2);
+            ASSERT_EQ(summary.errors.size(), 2);
+            EXPECT_NE(summary.errors[0].find("shared"), std::string::npos);
+            EXPECT_FALSE(std::filesystem::exists(output_dir / "a.txt"));
+            EXPECT_TRUE(std::filesystem::exists(output_dir / "c.txt"));
+        }
+
+        void MissingDirectory()
+        {
+            BatchProcessor<double> batch({}, {}, 10, 1);
+            EXPECT_THROW(batch.run(dir / "missing", output_dir), DataReaderException::FileNotFound);
+        }
+};
+
+TEST_F(BatchProcessorTest, WorkStealingPoolRunsNestedTasks) { this->WorkStealingPoolRunsNestedTasks(); }
+TEST_F(BatchProcessorTest, Run) { this->Run(); }
+TEST_F(BatchProcessorTest, SharedOutputs) { this->SharedOutputs(); }
+TEST_F(BatchProcessorTest, MissingDirectory) { this->MissingDirectory(); }
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <fstream>
+#include "binary_dataset.hpp"
+#include "data_reader.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Round trip tests for the binary dataset format
+ *
+ */
+class BinaryDatasetTest: public ::testing::Test {
+    protected:
+        Eigen::MatrixXd X;
+        std::filesystem::path path;
+
+        void SetUp() override {
+            X = Eigen::MatrixXd::Random(100, 3);
+            path = std::filesystem::temp_directory_path() / "test_binary_dataset.bin";
+            BinaryDataset<double>::write(path, X);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(path);
+        }
+
+        void MappedRoundTrip()
+        {
+            MappedDataset<double> mapped = BinaryDataset<double>::map(path);
+            ASSERT_EQ(mapped.rows(), X.rows());
+            ASSERT_EQ(mapped.cols(), X.cols());
+            EXPECT_TRUE(mapped.matrix() == X);
+        }
+
+        void ReadWithConversion()
+        {
+            Eigen::MatrixXf Xf = BinaryDataset<float>::read(path);
+            EXPECT_TRUE(Xf.isApprox(X.cast<float>()));
+            // Mapping requires the exact stored type
+            EXPECT_ANY_THROW(BinaryDataset<float>::map(path));
+        }
+
+        void DataReaderDetection()
+        {
+            EXPECT_TRUE(is_binary_dataset(path));
+            EXPECT_TRUE(DataReader<double>::read(path) == X);
+        }
+
+        void InvalidFiles()
+        {
+            // Text data file
+            std::ofstream(path) << "# 1 2\n1.0 2.0\n";
+            EXPECT_FALSE(is_binary_dataset(path));
+            EXPECT_ANY_THROW(BinaryDataset<double>::read(path));
+
+            // Truncated binary file
+            BinaryDataset<double>::write(path, X);
+            std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+            EXPECT_ANY_THROW(BinaryDataset<double>::read(path));
+
+            // Dimensions whose byte size wraps around 64 bits
+            BinaryDataset<double>::write(path, X);
+            BinaryDatasetHeader header = read_binary_dataset_header(path);
+            header.rows = (std::uint64_t(1) << 61) + 1;
+            header.cols = 8;
+            std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).write(reinterpret_cast<const char*>(&header), sizeof(header));
+            EXPECT_THROW(MappedDataset<double> mapped(path), DataReaderException);
+            header.cols = 0;
+            std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).write(reinterpret_cast<const char*>(&header), sizeof(header));
+            EXPECT_THROW(MappedDataset<double> mapped(path), DataReaderException);
+
+            // Element size inconsistent with the stored type
+            BinaryDataset<double>::write(path, X);
+            header = read_binary_dataset_header(path);
+            header.element_size = 1;
+            std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).write(reinterpret_cast<const char*>(&header), sizeof(header));
+            EXPECT_THROW(read_binary_dataset_header(path), DataReaderException);
+        }
+};
+
+TEST_F(BinaryDatasetTest, MappedRoundTrip) { this->MappedRoundTrip(); }
+TEST_F(BinaryDatasetTest, ReadWithConversion) { this->ReadWithConversion(); }
+TEST_F(BinaryDatasetTest, DataReaderDetection) { this->DataReaderDetection(); }
+TEST_F(BinaryDatasetTest, InvalidFiles) { this->InvalidFiles(); }
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <fstream>
+#include <sstream>
+#include "chunked_reader.hpp"
+#include "binary_dataset.hpp"
+#include "data_reader.hpp"
+#include "barycentric_interpolator.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Checks that reading a file by chunks gives back the same datapoints as
+ * reading it at once, for both the text & binary formats
+ *
+ */
+class ChunkedReaderTest: public ::testing::Test {
+    protected:
+        std::filesystem::path data_folder;
+        std::filesystem::path binary_path;
+        Eigen::MatrixXd X;
+
+        void SetUp() override {
+            data_folder = std::filesystem::path("../test/data/");
+            X = DataReader<double>::read(data_folder / "valid_datafile.txt");
+            binary_path = std::filesystem::temp_directory_path() / "test_chunked_reader.bin";
+            BinaryDataset<double>::write(binary_path, X);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(binary_path);
+        }
+
+        void ReadAllChunks(ChunkedReader<double>& reader, Eigen::Index chunk_rows)
+        {
+            ASSERT_EQ(reader.rows(), X.rows());
+            ASSERT_EQ(reader.cols(), X.cols());
+            Eigen::MatrixXd chunk;
+            Eigen::Index row = 0;
+            while (reader.next(chunk))
+            {
+                EXPECT_LE(chunk.rows(), chunk_rows);
+                EXPECT_TRUE(chunk == X.middleRows(row, chunk.rows()));
+                row += chunk.rows();
+            }
+            EXPECT_EQ(row, X.rows());
+        }
+
+        void TextChunks()
+        {
+            ChunkedReader<double> reader(data_folder / "valid_datafile.txt", 4);
+            this->ReadAllChunks(reader, 4);
+        }
+
+        void BinaryChunks()
+        {
+            ChunkedReader<double> reader(binary_path, 3);
+            this->ReadAllChunks(reader, 3);
+        }
+
+        void CorruptedBinaryHeader()
+        {
+            // FLOAT64 values declared 1 byte long would let the chunks read past the mapping
+            BinaryDatasetHeader header = read_binary_dataset_header(binary_path);
+            header.element_size = 1;
+            std::fstream(binary_path, std::ios::binary | std::ios::in | std::ios::out).write(reinterpret_cast<const char*>(&header), sizeof(header));
+            EXPECT_THROW(ChunkedReader<double>(binary_path, 3), DataReaderException);
+        }
+
+        void WrongDataSize()
+        {
+            ChunkedReader<double> reader(data_folder / "invalid_number_datapoints.txt", 2);
+            Eigen::MatrixXd chunk;
+            EXPECT_ANY_THROW(while (reader.next(chunk)) {});
+        }
+
+        void EvaluateChunks()
+        {
+            BarycentricInterpolator<double> interpolator;
+            interpolator.fit(X, 1);
+            std::istringstream queries("# 5 1\n-0.9\n-0.3\n0.1\n0.5\n0.95\n");
+            ChunkedReader<double> reader(queries, 2);
+            Eigen::Index count = evaluate_chunks<double>(interpolator, reader,
+                [&](const Eigen::MatrixXd& chunk, const Eigen::VectorXd& y) {
+                    for (Eigen::Index i = 0; i < chunk.rows(); i++)
+                    {
+                        EXPECT_DOUBLE_EQ(y(i), interpolator(chunk(i, 0)));
+                    }
+                });
+            EXPECT_EQ(count, 5);
+        }
+};
+
+TEST_F(ChunkedReaderTest, TextChunks) { this->TextChunks(); }
+TEST_F(ChunkedReaderTest, BinaryChunks) { this->BinaryChunks(); }
+TEST_F(ChunkedReaderTest, CorruptedBinaryHeader) { this->CorruptedBinaryHeader(); }
+TEST_F(ChunkedReaderTest, WrongDataSize) { this->WrongDataSize(); }
+TEST_F(ChunkedReaderTest, EvaluateChunks) { this->EvaluateChunks(); }
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <fstream>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#ifdef INTERPOLATION_HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
+#include "compressed_input.hpp"
+#include "chunked_reader.hpp"
+#include "data_reader.hpp"
+
+/**
+ * @brief Checks that compressed data files are read like the uncompressed ones
+ *
+ */
+class CompressedInputTest: public ::testing::Test {
+    protected:
+        std::filesystem::path text_path;
+        std::filesystem::path compressed_path;
+        Eigen::MatrixXd X;
+
+        void SetUp() override {
+            text_path = std::filesystem::path("../test/data/valid_datafile.txt");
+            compressed_path = std::filesystem::temp_directory_path() / "test_compressed_input.dat";
+            X = DataReader<double>::read(text_path);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(compressed_path);
+        }
+
+        template <typename Compressor>
+        void Compress(Compressor compressor)
+        {
+            std::ifstream input(text_path, std::ios::binary);
+            std::ofstream output(compressed_path, std::ios::binary);
+            boost::iostreams::filtering_ostream out;
+            out.push(compressor);
+            out.push(output);
+            out << input.rdbuf();
+        }
+
+        void Gzip()
+        {
+            this->Compress(boost::iostreams::gzip_compressor());
+            // Detected from the magic bytes, whatever the extension
+            EXPECT_EQ(detect_compression(compressed_path), Compression::GZIP);
+            EXPECT_TRUE(DataReader<double>::read(compressed_path) == X);
+
+            ChunkedReader<double> reader(compressed_path, 4);
+            Eigen::MatrixXd chunk;
+            Eigen::Index rows = 0;
+            while (reader.next(chunk)) { rows += chunk.rows(); }
+            EXPECT_EQ(rows, X.rows());
+        }
+
+        void Zstd()
+        {
+#ifdef INTERPOLATION_HAVE_ZSTD
+            this->Compress(boost::iostreams::zstd_compressor());
+            EXPECT_EQ(detect_compression(compressed_path), Compression::ZSTD);
+            EXPECT_TRUE(DataReader<double>::read(compressed_path) == X);
+#else
+            GTEST_SKIP() << "zstd support not compiled in";
+#endif
+        }
+
+        void Extension()
+        {
+            EXPECT_EQ(detect_compression("missing_file.txt.gz"), Compression::GZIP);
+            EXPECT_EQ(detect_compression("missing_file.zst"), Compression::ZSTD);
+            EXPECT_EQ(detect_compression(text_path), Compression::NONE);
+            // Plain text named as a compressed file
+            std::filesystem::path plain_path = std::filesystem::temp_directory_path() / "test_compressed_input_plain.txt.gz";
+            std::ofstream(plain_path) << "# 1 2\n1.0 2.0\n";
+            EXPECT_EQ(detect_compression(plain_path), Compression::NONE);
+            EXPECT_EQ(DataReader<double>::read(plain_path).rows(), 1);
+            std::filesystem::remove(plain_path);
+        }
+
+        void Corrupted()
+        {
+            std::ofstream(compressed_path, std::ios::binary) << "\x1f\x8b" << "definitely not deflate data";
+            EXPECT_ANY_THROW(DataReader<double>::read(compressed_path));
+        }
+};
+
+TEST_F(CompressedInputTest, Gzip) { this->Gzip(); }
+TEST_F(CompressedInputTest, Zstd) { this->Zstd(); }
+TEST_F(CompressedInputTest, Extension) { this->Extension(); }
+TEST_F(CompressedInputTest, Corrupted) { this->Corrupted(); }
@@ -2,6 +2,7 @@
 #include <Eigen/Core>
 #include "datagen.hpp"
 #include "cubic_spline_interpolator.hpp"
+#include "interpolation_kernels.hpp"
 #include "test_polynomial_interpolator.cpp"
 
 class CubicSplineInterpolatorTest: public PolynomialInterpolatorTest {
@@ -10,6 +11,51 @@ class CubicSplineInterpolatorTest: public PolynomialInterpolatorTest {
             interpolator = (PolynomialInterpolator<double>*) new CubicSplineInterpolator<double>();
             PolynomialInterpolatorTest::SetUp();
         };
+
+        void CompensatedSummation()
+        {
+            // The Horner sums cancel around the roots of the oscillations
+            Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(50, -1.0, 1.0);
+            Eigen::VectorXd y = 1e3 * (20 * x.array()).cos();
+            Eigen::VectorXd queries = Eigen::VectorXd::LinSpaced(1001, -0.99, 0.99);
+
+            CubicSplineInterpolator<double> spline;
+            spline.fit(x, y);
+            Eigen::VectorXd standard = spline(queries);
+            spline.set_summation_mode(SummationMode::COMPENSATED);
+            Eigen::VectorXd compensated = spline(queries);
+
+            // Reference: the same coefficients in long double, relative errors
+            Eigen::VectorX<long double> X = x.cast<long double>();
+            Eigen::MatrixX<long double> C = spline.get_coefficients().cast<long double>();
+            long double standard_error = 0, compensated_error = 0;
+            for (Eigen::Index i=0; i<queries.rows(); i++)
+            {
+                const long double reference = spline_kernel<long double>(queries(i), X.data(), C.data(), x.rows(), -1, 1);
+                standard_error = std::max(standard_error, std::abs((standard(i) - reference) / reference));
+                compensated_error = std::max(compensated_error, std::abs((compensated(i) - reference) / reference));
+            }
+            EXPECT_LT(compensated_error, 2 * std::numeric_limits<double>::epsilon());
+            EXPECT_LT(compensated_error, standard_error);
+        }
+
+        void MixedPrecision()
+        {
+            // Float storage & double evaluation against the double spline
+            Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(500, -1.0, 1.0);
+            Eigen::VectorXd y = x.array().exp() * (5 * x.array()).sin() + 2;
+            Eigen::VectorXd queries = Eigen::VectorXd::LinSpaced(2001, -1.0, 1.0);
+
+            CubicSplineInterpolator<double> reference;
+            CubicSplineInterpolator<double, float> mixed;
+            reference.fit(x, y);
+            mixed.fit(x, y);
+            static_assert(std::is_same_v<std::decay_t<decltype(mixed.get_coefficients())>, Eigen::MatrixX4f>);
+
+            // 2^-24 (max|y| + max|x| max|y'|), max|y'| < 5.1 e
+            const double bound = std::ldexp(1.0, -24) * (y.cwiseAbs().maxCoeff() + 5.1 * std::exp(1.0));
+            EXPECT_LT((mixed(queries) - reference(queries)).cwiseAbs().maxCoeff(), bound);
+        }
 };
 
 
@@ -19,8 +65,11 @@ TEST_F(CubicSplineInterpolatorTest, FitDataUsingY)  {this->FitDataUsingY();}
 TEST_F(CubicSplineInterpolatorTest, FitRange)       {this->FitRange();}
 TEST_F(CubicSplineInterpolatorTest, VectorDatapoints) {this->VectorDatapoints();}
 TEST_F(CubicSplineInterpolatorTest, Extrapolation) {this->Extrapolation();}
+TEST_F(CubicSplineInterpolatorTest, ExtrapolationPolicies) {this->ExtrapolationPolicies();}
 TEST_F(CubicSplineInterpolatorTest, SingleDataPoint) {this->SingleDataPoint();}
 TEST_F(CubicSplineInterpolatorTest, Multidimensional) {this->Multidimensional();}
+TEST_F(CubicSplineInterpolatorTest, CompensatedSummation) {this->CompensatedSummation();}
+TEST_F(CubicSplineInterpolatorTest, MixedPrecision) {this->MixedPrecision();}
 
 class ClampedCubicSplineInterpolatorTest: public PolynomialInterpolatorTest {
     protected:
@@ -35,5 +84,6 @@ TEST_F(ClampedCubicSplineInterpolatorTest, FitDataUsingY)  {this->FitDataUsingY(
 TEST_F(ClampedCubicSplineInterpolatorTest, FitRange)       {this->FitRange();}
 TEST_F(ClampedCubicSplineInterpolatorTest, VectorDatapoints) {this->VectorDatapoints();}
 TEST_F(ClampedCubicSplineInterpolatorTest, Extrapolation) {this->Extrapolation();}
+TEST_F(ClampedCubicSplineInterpolatorTest, ExtrapolationPolicies) {this->ExtrapolationPolicies();}
 TEST_F(ClampedCubicSplineInterpolatorTest, SingleDataPoint) {this->SingleDataPoint();}
 TEST_F(ClampedCubicSplineInterpolatorTest, Multidimensional) {this->Multidimensional();}
\ No newline at end of file
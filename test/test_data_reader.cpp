@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "data_reader.hpp"
+#include "block_tokenizer.hpp"
+#include "project_exceptions.hpp"
+#include <sstream>
 
 class DataReaderTest: public ::testing::Test {
     protected:
@@ -40,6 +43,31 @@ class DataReaderTest: public ::testing::Test {
             EXPECT_ANY_THROW(reader->read(data_folder.concat("invalid_number_datapoints.txt")));
         }
 
+        void TokensAcrossBlocks()
+        {
+            // Tiny blocks force tokens to straddle several reads
+            std::istringstream stream("# 2 2\n  1.25 -3e2\n+4   123456789.5 \n");
+            BlockTokenizer tokenizer(stream, 3);
+            std::vector<std::string> expected = {"#", "2", "2", "1.25", "-3e2", "+4", "123456789.5"};
+            for (const auto& e : expected)
+            {
+                EXPECT_EQ(tokenizer.next(), e);
+            }
+            EXPECT_TRUE(tokenizer.next().empty());
+
+            std::istringstream data("# 2 2\n  1.25 -3e2\n+4   123456789.5 \n");
+            Eigen::MatrixXd X = reader->read(data);
+            EXPECT_DOUBLE_EQ(X(0,1), -300.0);
+            EXPECT_DOUBLE_EQ(X(1,0), 4.0);
+            EXPECT_DOUBLE_EQ(X(1,1), 123456789.5);
+        }
+
+        void PartiallyNumericDatapoint()
+        {
+            std::istringstream data("# 1 2\n1.0 2.0abc\n");
+            EXPECT_THROW(reader->read(data), DataReaderException::NotANumber);
+        }
+
         void ExpectedFormat()
         {
             EXPECT_NO_THROW(reader->read(data_folder.concat("valid_datafile.txt")));
@@ -52,4 +80,6 @@ TEST_F(DataReaderTest, NonNumericDatapoint) { this->NonNumericDatapoint(); }
 TEST_F(DataReaderTest, NonCoherentDatapointCount) { this->NonCoherentDatapointCount(); }
 TEST_F(DataReaderTest, ExpectedFormat) { this->ExpectedFormat(); }
 TEST_F(DataReaderTest, NoHashTagDelimiter) { this->NoHashTagDelimiter(); }
+TEST_F(DataReaderTest, TokensAcrossBlocks) { this->TokensAcrossBlocks(); }
+TEST_F(DataReaderTest, PartiallyNumericDatapoint) { this->PartiallyNumericDatapoint(); }
 
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <fstream>
+#include <sstream>
+#include "binary_dataset.hpp"
+#include "data_reader.hpp"
+#include "data_writer.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Checks that the written text & binary files are read back exactly
+ *
+ */
+class DataWriterTest: public ::testing::Test {
+    protected:
+        std::filesystem::path path;
+        Eigen::MatrixXd X;
+
+        void SetUp() override {
+            path = std::filesystem::temp_directory_path() / "test_data_writer.txt";
+            X = Eigen::MatrixXd::Random(10000, 3);
+            X(0, 0) = 1e-300;
+            X(1, 1) = -123456789.0;
+            X(2, 2) = 0.1;
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(path);
+        }
+
+        std::string Contents()
+        {
+            std::ifstream file(path);
+            std::stringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        }
+
+        void RoundTrip()
+        {
+            // Shortest representation is exact
+            DataWriter<double>::write(path, X);
+            EXPECT_TRUE(DataReader<double>::read(path) == X);
+
+            Eigen::MatrixXi I = Eigen::MatrixXi::Random(50, 2);
+            DataWriter<int>::write(path, I);
+            EXPECT_TRUE(DataReader<int>::read(path) == I);
+        }
+
+        void Precision()
+        {
+            Eigen::MatrixXd Y(1, 2);
+            Y << 3.14159265358979, 2.0;
+            DataWriter<double>::write(path, Y, DataFormat::TEXT, 3);
+            EXPECT_EQ(this->Contents(), "# 1 2\n3.14 2\n");
+        }
+
+        void ParallelKeepsOrder()
+        {
+            DataWriter<double>::write(path, X, DataFormat::TEXT, -1, 1);
+            std::string serial = this->Contents();
+            DataWriter<double>::write(path, X, DataFormat::TEXT, -1, 4);
+            EXPECT_EQ(this->Contents(), serial);
+        }
+
+        void StreamedBinary()
+        {
+            DataWriter<double> writer(path, X.rows(), X.cols(), DataFormat::BINARY);
+            for (Eigen::Index first = 0; first < X.rows(); first += 3000)
+            {
+                Eigen::Index rows = std::min<Eigen::Index>(3000, X.rows() - first);
+                writer.write_rows(X.middleRows(first, rows));
+            }
+            writer.close();
+            EXPECT_TRUE(BinaryDataset<double>::read(path) == X);
+        }
+
+        void WrongRowCount()
+        {
+            DataWriter<double> writer(path, 5, 3);
+            EXPECT_THROW(writer.write_rows(X.topRows(6)), DataWriterException);
+            EXPECT_THROW(writer.write_rows(X.topRows(2).leftCols(2)), DataWriterException);
+            writer.write_rows(X.topRows(2));
+            EXPECT_THROW(writer.close(), DataWriterException);
+        }
+};
+
+TEST_F(DataWriterTest, RoundTrip) { this->RoundTrip(); }
+TEST_F(DataWriterTest, Precision) { this->Precision(); }
+TEST_F(DataWriterTest, ParallelKeepsOrder) { this->ParallelKeepsOrder(); }
+TEST_F(DataWriterTest, StreamedBinary) { this->StreamedBinary(); }
+TEST_F(DataWriterTest, WrongRowCount) { this->WrongRowCount(); }
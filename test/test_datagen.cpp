@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <cmath>
+#include "binary_dataset.hpp"
+#include "datagen.hpp"
+
+/**
+ * @brief Checks the 1D & multi-dimensional function generation
+ *
+ */
+class DatagenTest: public ::testing::Test {
+    protected:
+        using Monomial = datagen<double>::Monomial;
+        using PointSpec = datagen<double>::PointSpec;
+        using PointSet = datagen<double>::PointSet;
+
+        void Horner()
+        {
+            Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(11, -2.0, 3.0);
+            Eigen::VectorXd coeffs(4);
+            coeffs << 1.0, -2.0, 0.5, 3.0;
+            Eigen::VectorXd y(x.rows());
+            datagen<double>::polynomial(y, x, coeffs);
+            for (Eigen::Index i = 0; i < x.rows(); i++)
+            {
+                double expected = 1.0 - 2.0*x(i) + 0.5*x(i)*x(i) + 3.0*x(i)*x(i)*x(i);
+                EXPECT_NEAR(y(i), expected, 1e-12);
+            }
+        }
+
+        void TensorPolynomial()
+        {
+            // f(x, y) = 2 + x y^2 - 3 x^3
+            std::vector<Monomial> terms = {{2.0, {}}, {1.0, {1, 2}}, {-3.0, {3}}};
+            PointSpec spec{{{-1.0, 1.0}, {0.0, 2.0}}, {4, 3}};
+            Eigen::MatrixXd data;
+            datagen<double>::polynomial(data, terms, spec);
+            ASSERT_EQ(data.rows(), 12);
+            ASSERT_EQ(data.cols(), 3);
+            // Dimension 0 varies fastest
+            EXPECT_EQ(data(1, 0), -1.0 + 2.0/3.0);
+            EXPECT_EQ(data(1, 1), 0.0);
+            EXPECT_EQ(data(4, 1), 1.0);
+            for (Eigen::Index i = 0; i < data.rows(); i++)
+            {
+                double x = data(i, 0), y = data(i, 1);
+                EXPECT_NEAR(data(i, 2), 2.0 + x*y*y - 3.0*x*x*x, 1e-12);
+            }
+
+            std::vector<Monomial> invalid = {{1.0, {1, 1, 1}}};
+            EXPECT_THROW(datagen<double>::polynomial(data, invalid, spec), std::invalid_argument);
+        }
+
+        void RadialDampedCosine()
+        {
+            Eigen::VectorXd params(3);
+            params << 2.0, 0.5, 3.0;
+            PointSpec spec{{{-1.0, 1.0}, {-1.0, 1.0}, {-1.0, 1.0}}, {500}, PointSet::SCATTERED};
+            Eigen::MatrixXd data;
+            datagen<double>::damped_cosine(data, params, spec);
+            ASSERT_EQ(data.rows(), 500);
+            EXPECT_GE(data.leftCols(3).minCoeff(), -1.0);
+            EXPECT_LT(data.leftCols(3).maxCoeff(), 1.0);
+            for (Eigen::Index i = 0; i < data.rows(); i++)
+            {
+                double r = data.row(i).head(3).norm();
+                EXPECT_NEAR(data(i, 3), 2.0*std::exp(-0.5*r*r)*std::cos(3.0*r), 1e-12);
+            }
+        }
+
+        void Streamed()
+        {
+            std::filesystem::path path = std::filesystem::temp_directory_path() / "test_datagen.bin";
+            std::vector<Monomial> terms = {{1.0, {2}}, {1.0, {0, 2}}};
+            PointSpec spec{{{0.0, 1.0}, {0.0, 1.0}}, {DATAGEN_CHUNK_ROWS + 7}, PointSet::SCATTERED};
+            datagen<double>::polynomial(path, terms, spec, DataFormat::BINARY);
+            Eigen::MatrixXd data;
+            datagen<double>::polynomial(data, terms, spec);
+            EXPECT_TRUE(BinaryDataset<double>::read(path) == data);
+            std::filesystem::remove(path);
+        }
+};
+
+TEST_F(DatagenTest, Horner) { this->Horner(); }
+TEST_F(DatagenTest, TensorPolynomial) { this->TensorPolynomial(); }
+TEST_F(DatagenTest, RadialDampedCosine) { this->RadialDampedCosine(); }
+TEST_F(DatagenTest, Streamed) { this->Streamed(); }
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <fstream>
+#include "dataset_cache.hpp"
+#include "data_reader.hpp"
+
+/**
+ * @brief Checks that datasets are parsed once and invalidated when the file changes
+ *
+ */
+class DatasetCacheTest: public ::testing::Test {
+    protected:
+        DatasetCache<double> cache;
+        std::filesystem::path path;
+
+        void SetUp() override {
+            path = std::filesystem::temp_directory_path() / "test_dataset_cache.txt";
+            std::ofstream(path) << "# 3 2\n0.0 0.0\n1.0 1.0\n2.0 4.0\n";
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(path);
+        }
+
+        void ParseOnce()
+        {
+            auto first = cache.get(path);
+            auto second = cache.get(path);
+            EXPECT_EQ(first.get(), second.get());
+            EXPECT_EQ(cache.misses(), 1);
+            EXPECT_EQ(cache.hits(), 1);
+            EXPECT_EQ(cache.size(), 1);
+        }
+
+        void InvalidatedOnChange()
+        {
+            auto first = cache.get(path);
+            std::ofstream(path) << "# 4 2\n0.0 0.0\n1.0 1.0\n2.0 4.0\n3.0 9.0\n";
+            auto second = cache.get(path);
+            EXPECT_EQ(second->rows(), 4);
+            EXPECT_EQ(cache.misses(), 2);
+            // Previously returned datasets stay valid
+            EXPECT_EQ(first->rows(), 3);
+        }
+
+        void FailedParseNotCached()
+        {
+            std::ofstream(path) << "3 2\n";
+            EXPECT_ANY_THROW(cache.get(path));
+            EXPECT_EQ(cache.size(), 0);
+        }
+
+        void LeastRecentlyUsedEvicted()
+        {
+            // Budget of two 3x2 datasets
+            DatasetCache<double> small(2 * 6 * sizeof(double));
+            std::filesystem::path other = std::filesystem::temp_directory_path() / "test_dataset_cache_other.txt";
+            std::filesystem::path third = std::filesystem::temp_directory_path() / "test_dataset_cache_third.txt";
+            std::filesystem::copy_file(path, other, std::filesystem::copy_options::overwrite_existing);
+            std::filesystem::copy_file(path, third, std::filesystem::copy_options::overwrite_existing);
+            auto first = small.get(path);
+            small.get(other);
+            small.get(path);
+            small.get(third);
+            EXPECT_EQ(small.size(), 2);
+            EXPECT_EQ(small.bytes(), 2 * 6 * sizeof(double));
+            // 'other' was the least recently used
+            small.get(path);
+            EXPECT_EQ(small.misses(), 3);
+            small.get(other);
+            EXPECT_EQ(small.misses(), 4);
+            // Evicted datasets stay valid for their holders
+            EXPECT_EQ(first->rows(), 3);
+            std::filesystem::remove(other);
+            std::filesystem::remove(third);
+        }
+
+        void SharedByFactory()
+        {
+            std::size_t misses = DatasetCache<double>::global().misses();
+            std::vector<std::string> options = {};
+            auto lagrange = DataReader<double>::interpolator_from_file(path, "lagrange", options, 1);
+            auto barycentric = DataReader<double>::interpolator_from_file(path, "barycentric", options, 1);
+            EXPECT_EQ(DatasetCache<double>::global().misses(), misses + 1);
+            EXPECT_DOUBLE_EQ((*lagrange)(1.5), (*barycentric)(1.5));
+        }
+};
+
+TEST_F(DatasetCacheTest, ParseOnce) { this->ParseOnce(); }
+TEST_F(DatasetCacheTest, InvalidatedOnChange) { this->InvalidatedOnChange(); }
+TEST_F(DatasetCacheTest, FailedParseNotCached) { this->FailedParseNotCached(); }
+TEST_F(DatasetCacheTest, LeastRecentlyUsedEvicted) { this->LeastRecentlyUsedEvicted(); }
+TEST_F(DatasetCacheTest, SharedByFactory) { this->SharedByFactory(); }
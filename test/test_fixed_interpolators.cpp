@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include "barycentric_interpolator.hpp"
+#include "fixed_interpolators.hpp"
+#include "lagrange_interpolator.hpp"
+#include "project_exceptions.hpp"
+
+/* Weights of the stencil {-1, 0, 1, 2} computed at compile time */
+constexpr std::array<double, 4> STENCIL = {-1.0, 0.0, 1.0, 2.0};
+constexpr std::array<double, 4> STENCIL_WEIGHTS = fixed_barycentric_weights(STENCIL);
+static_assert(STENCIL_WEIGHTS[0] == -1.0 / 6 && STENCIL_WEIGHTS[1] == 0.5 && STENCIL_WEIGHTS[2] == -0.5 && STENCIL_WEIGHTS[3] == 1.0 / 6);
+
+/**
+ * @brief Compares the fixed-size interpolators to the dynamic ones fitted on the same datapoints
+ *
+ */
+class FixedInterpolatorsTest: public ::testing::Test {
+    protected:
+        template <int N>
+        void CompareToDynamic()
+        {
+            using Vector = Eigen::Matrix<double, N, 1>;
+            const Vector x = Vector::LinSpaced(-1.0, 1.0) + 0.01 * Vector::Random();
+            const Vector y = (3.0 * x.array()).sin().matrix();
+            const Eigen::VectorXd queries = Eigen::VectorXd::LinSpaced(101, x.minCoeff(), x.maxCoeff());
+
+            BarycentricInterpolator<double> barycentric;
+            LagrangeInterpolator<double> lagrange;
+            barycentric.fit(Eigen::MatrixXd(x), Eigen::VectorXd(y));
+            lagrange.fit(Eigen::MatrixXd(x), Eigen::VectorXd(y));
+            FixedBarycentricInterpolator<double, N> fixed_barycentric;
+            FixedLagrangeInterpolator<double, N> fixed_lagrange;
+            fixed_barycentric.fit(x, y);
+            fixed_lagrange.fit(x, y);
+
+            EXPECT_TRUE(fixed_barycentric.get_weights().isApprox(barycentric.get_weights().col(0), 1e-12));
+            EXPECT_TRUE(fixed_barycentric(queries).isApprox(barycentric(queries), 1e-12)) << N;
+            EXPECT_TRUE(fixed_lagrange(queries).isApprox(lagrange(queries), 1e-10)) << N;
+            for (int i=0; i<N; i++)
+            {
+                EXPECT_EQ(fixed_barycentric(x(i)), y(i));
+                EXPECT_NEAR(fixed_lagrange(x(i)), y(i), 1e-12);
+            }
+        }
+
+        void Sizes()
+        {
+            this->CompareToDynamic<4>();
+            this->CompareToDynamic<8>();
+            this->CompareToDynamic<16>();
+        }
+
+        void CompileTimeWeights()
+        {
+            // Cubic through the stencil: exact for any cubic polynomial
+            FixedBarycentricInterpolator<double, 4> barycentric(STENCIL, STENCIL_WEIGHTS);
+            FixedLagrangeInterpolator<double, 4> lagrange(STENCIL, STENCIL_WEIGHTS);
+            auto cubic = [](double v) { return 2.0 * v * v * v - v + 3.0; };
+            for (const Eigen::Vector4d& values : {Eigen::Vector4d(0, 1, 2, 3), Eigen::Vector4d(cubic(-1), cubic(0), cubic(1), cubic(2))})
+            {
+                barycentric.set_values(values);
+                lagrange.set_values(values);
+                EXPECT_NEAR(barycentric(0.5), lagrange(0.5), 1e-14);
+            }
+            EXPECT_NEAR(barycentric(0.25), cubic(0.25), 1e-14);
+            EXPECT_NEAR(lagrange(1.75), cubic(1.75), 1e-14);
+            EXPECT_EQ(barycentric.get_range(), std::make_pair(-1.0, 2.0));
+        }
+
+        void Extrapolation()
+        {
+            FixedBarycentricInterpolator<double, 4> barycentric(STENCIL, STENCIL_WEIGHTS);
+            barycentric.set_values(Eigen::Vector4d(1, 2, 3, 4));
+            EXPECT_THROW(barycentric(2.5), InterpolationProjectException::Extrapolation);
+            barycentric.set_extrapolation_policy(ExtrapolationPolicy::CLAMP);
+            EXPECT_EQ(barycentric(2.5), 4.0);
+            barycentric.set_extrapolation_policy(ExtrapolationPolicy::NAN_VALUE);
+            EXPECT_TRUE(std::isnan(barycentric(-3.0)));
+            barycentric.set_extrapolation_policy(ExtrapolationPolicy::EXTRAPOLATE);
+            EXPECT_NEAR(barycentric(3.0), 5.0, 1e-14);
+        }
+
+        void Errors()
+        {
+            FixedLagrangeInterpolator<double, 4> lagrange;
+            EXPECT_THROW(lagrange.fit(Eigen::Vector4d(0, 1, 1, 2), Eigen::Vector4d::Zero()), InterpolationProjectException::DivisionByZero);
+            lagrange.fit(Eigen::Vector4d(0, 1, 2, 3), Eigen::Vector4d::Zero());
+            EXPECT_THROW(lagrange(Eigen::MatrixXd::Zero(3, 2)), InterpolationProjectException::MultidimensionalImplementation);
+        }
+};
+
+TEST_F(FixedInterpolatorsTest, Sizes) { this->Sizes(); }
+TEST_F(FixedInterpolatorsTest, CompileTimeWeights) { this->CompileTimeWeights(); }
+TEST_F(FixedInterpolatorsTest, Extrapolation) { this->Extrapolation(); }
+TEST_F(FixedInterpolatorsTest, Errors) { this->Errors(); }
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <numbers>
+#include "fourier_approximator.hpp"
+#include "interpolator.hpp"
+
+/**
+ * @brief Resamples band-limited periodic signals, which the trigonometric interpolant reproduces exactly
+ *
+ */
+class FourierApproximatorTest: public ::testing::Test {
+    protected:
+        /* 1 + cos(3t) + 0.5 sin(2t) at n equispaced points of [0, 2 pi) */
+        static Eigen::VectorXd Signal(int n, double shift = 0.0)
+        {
+            Eigen::ArrayXd t = Eigen::ArrayXd::LinSpaced(n, 0, n - 1) * (2.0 * std::numbers::pi / n);
+            return (1.0 + shift + (3.0 * t).cos() + 0.5 * (2.0 * t).sin()).matrix();
+        }
+
+        void Resample()
+        {
+            for (int N : {15, 16})
+            {
+                FourierApproximator<double> approximator;
+                approximator.fit(Signal(N));
+                EXPECT_EQ(approximator.get_spectrum().size(), N / 2 + 1);
+                EXPECT_TRUE(approximator.approximate_points(N).isApprox(Signal(N), 1e-12));
+                for (int n : {8, 10, 13, 37, 64})
+                {
+                    EXPECT_TRUE(approximator.approximate_points(n).isApprox(Signal(n), 1e-12)) << N << " -> " << n;
+                }
+            }
+        }
+
+        void NyquistBin()
+        {
+            // cos(pi j) on 8 samples: the 16 points interpolant is cos(4t), sampled at the odd points as 0
+            Eigen::VectorXd v(8);
+            v << 1, -1, 1, -1, 1, -1, 1, -1;
+            FourierApproximator<double> approximator;
+            approximator.fit(v);
+            Eigen::VectorXd upsampled = approximator.approximate_points(16);
+            for (int i=0; i<16; i++)
+            {
+                EXPECT_NEAR(upsampled(i), std::cos(4.0 * 2.0 * std::numbers::pi * i / 16), 1e-12);
+            }
+        }
+
+        void Domain()
+        {
+            FourierApproximator<double> approximator;
+            approximator.fit(Signal(16), -1.0, 1.0);
+            Eigen::MatrixXd points = approximator.approximate(8);
+            EXPECT_TRUE(points.col(0).isApprox(Eigen::VectorXd::LinSpaced(8, -1.0, 0.75)));
+            EXPECT_TRUE(points.col(1).isApprox(Signal(8), 1e-12));
+            EXPECT_THROW(approximator.fit(Signal(16), 1.0, 1.0), InterpolationProjectException);
+        }
+
+        void Batch()
+        {
+            Eigen::MatrixXd signals(16, 3);
+            for (int j=0; j<3; j++) { signals.col(j) = Signal(16, j); }
+            FourierApproximator<double> approximator;
+            Eigen::MatrixXd resampled = approximator.resample(signals, 40);
+            ASSERT_EQ(resampled.rows(), 40);
+            ASSERT_EQ(resampled.cols(), 3);
+            for (int j=0; j<3; j++)
+            {
+                EXPECT_TRUE(resampled.col(j).isApprox(Signal(40, j), 1e-12));
+            }
+        }
+
+        /* Sum of cos(k t + k / 3) / (1 + k) for k < 31, band-limited for 64 samples of [0, 2 pi) */
+        static double Wave(double t)
+        {
+            double sum = 0.0;
+            for (int k=0; k<31; k++) { sum += std::cos(k * t + k / 3.0) / (1.0 + k); }
+            return sum;
+        }
+
+        void ArbitraryPoints()
+        {
+            const double period = 2.0 * std::numbers::pi;
+            Eigen::MatrixXd X(64, 2);
+            X.col(0) = Eigen::VectorXd::LinSpaced(64, 0.0, 63.0) * (period / 64);
+            X.col(1) = X.col(0).unaryExpr(&Wave);
+            Eigen::VectorXd queries = (Eigen::VectorXd::Random(500).array() + 1.0) * (period / 2);
+
+            for (double tolerance : {1e-4, 1e-8, 1e-12})
+            {
+                FourierApproximator<double> approximator(tolerance);
+                Interpolator<double>& interpolator = approximator;
+                interpolator.fit(X, 1);
+                const Eigen::VectorXd values = interpolator(queries);
+                const double error = (values - queries.unaryExpr(&Wave)).cwiseAbs().maxCoeff();
+                EXPECT_LT(error, 10 * tolerance * X.col(1).cwiseAbs().maxCoeff()) << "tolerance " << tolerance;
+                EXPECT_NEAR(interpolator(queries(0)), values(0), 1e-15);
+            }
+        }
+
+        void Extrapolation()
+        {
+            Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(16, -1.0, 0.875);
+            FourierApproximator<double> approximator;
+            approximator.fit(x, x.unaryExpr([](double v) { return std::sin(std::numbers::pi * v); }));
+            EXPECT_EQ(approximator.get_range(), std::make_pair(-1.0, 1.0));
+            EXPECT_NEAR(approximator(0.9), std::sin(std::numbers::pi * 0.9), 1e-8);
+            EXPECT_THROW(approximator(1.5), InterpolationProjectException::Extrapolation);
+            approximator.set_extrapolation_policy(ExtrapolationPolicy::EXTRAPOLATE);
+            EXPECT_NEAR(approximator(2.5), std::sin(std::numbers::pi * 0.5), 1e-8);
+
+            // Non equispaced samples
+            x(3) += 0.01;
+            EXPECT_THROW(approximator.fit(x, x), InterpolationProjectException);
+        }
+
+        void Streaming()
+        {
+            // Stream of a non band-limited signal, the window is compared to a fit of the same samples
+            const int N = 64, P = 5000;
+            Eigen::ArrayXd t = Eigen::ArrayXd::LinSpaced(N + P, 0, N + P - 1) * 0.1;
+            Eigen::VectorXd stream = ((0.7 * t).sin() + 0.2 * (0.05 * t * t).cos()).matrix();
+
+            FourierApproximator<double> streamed;
+            streamed.fit(stream.head(N), 0.0, N * 0.1);
+            for (int i=0; i<P; i++)
+            {
+                streamed.push(stream(N + i));
+            }
+            FourierApproximator<double> fitted;
+            fitted.fit(stream.tail(N), P * 0.1, (N + P) * 0.1);
+            EXPECT_NEAR(streamed.get_range().first, fitted.get_range().first, 1e-9);
+            EXPECT_NEAR(streamed.get_range().second, fitted.get_range().second, 1e-9);
+            EXPECT_LT((streamed.get_spectrum() - fitted.get_spectrum()).cwiseAbs().maxCoeff(), 1e-9);
+
+            // The NUFFT grid is rebuilt for the new window, synthesize sums the spectrum directly
+            Eigen::VectorXd queries = Eigen::VectorXd::LinSpaced(33, streamed.get_range().first, streamed.get_range().second);
+            EXPECT_TRUE(streamed(queries).isApprox(fitted(queries), 1e-8));
+            EXPECT_TRUE(streamed.synthesize(queries).isApprox(fitted(queries), 1e-8));
+            EXPECT_THROW(streamed(0.0), InterpolationProjectException::Extrapolation);
+        }
+
+        void TrackedBins()
+        {
+            // Periodic stream of Signal(N)
+            const int N = 32;
+            Eigen::VectorXd signal(N + 100);
+            for (int i=0; i<N+100; i++) { signal(i) = Signal(N)(i % N); }
+            FourierApproximator<double> streamed;
+            streamed.fit(signal.head(N));
+            streamed.track_bins({3, 0, 2});
+            EXPECT_EQ(streamed.get_bins(), std::vector<Eigen::Index>({0, 2, 3}));
+            EXPECT_EQ(streamed.get_spectrum()(1), std::complex<double>(0.0));
+            streamed.push(Eigen::VectorXd(signal.tail(100)));
+            streamed.renormalize();
+
+            // Signal() only has the 0, 2 & 3 frequencies: the tracked bins are the whole spectrum
+            FourierApproximator<double> fitted;
+            fitted.fit(signal.tail(N), 100.0, 100.0 + N);
+            EXPECT_LT((streamed.get_spectrum() - fitted.get_spectrum()).cwiseAbs().maxCoeff(), 1e-9);
+            Eigen::VectorXd queries = Eigen::VectorXd::LinSpaced(10, 100.0, 100.0 + N);
+            EXPECT_TRUE(streamed.synthesize(queries).isApprox(fitted(queries), 1e-9));
+            EXPECT_THROW(streamed.track_bins({N}), InterpolationProjectException::IndexOutOfBounds);
+        }
+
+        void Errors()
+        {
+            FourierApproximator<double> approximator;
+            EXPECT_THROW(approximator.approximate_points(10), InterpolationProjectException);
+            approximator.fit(Signal(16));
+            EXPECT_THROW(approximator.approximate_points(0), InterpolationProjectException);
+        }
+};
+
+TEST_F(FourierApproximatorTest, Resample) { this->Resample(); }
+TEST_F(FourierApproximatorTest, NyquistBin) { this->NyquistBin(); }
+TEST_F(FourierApproximatorTest, Domain) { this->Domain(); }
+TEST_F(FourierApproximatorTest, Batch) { this->Batch(); }
+TEST_F(FourierApproximatorTest, ArbitraryPoints) { this->ArbitraryPoints(); }
+TEST_F(FourierApproximatorTest, Extrapolation) { this->Extrapolation(); }
+TEST_F(FourierApproximatorTest, Streaming) { this->Streaming(); }
+TEST_F(FourierApproximatorTest, TrackedBins) { this->TrackedBins(); }
+TEST_F(FourierApproximatorTest, Errors) { this->Errors(); }
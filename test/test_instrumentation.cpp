@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "data_reader.hpp"
+#include "instrumentation.hpp"
+
+/**
+ * @brief Checks the statistics counters (built into the tests_stats target, with INTERPOLATION_STATS)
+ *
+ */
+class InstrumentationTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            ASSERT_TRUE(Stats::enabled()) << "statistics not compiled in, INTERPOLATION_STATS must be defined";
+            Stats::reset();
+        }
+
+        void Counters()
+        {
+            Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(11, 0.0, 1.0);
+            Eigen::MatrixXd data(11, 2);
+            data << x, x.array().square().matrix();
+
+            BarycentricInterpolator<double> barycentric;
+            barycentric.fit(data, 1);
+            barycentric.set_extrapolation_policy(ExtrapolationPolicy::NAN_VALUE);
+            Eigen::MatrixXd queries(3, 1);
+            queries << 0.5, 0.55, 2.0;
+            barycentric(queries);
+            EXPECT_ANY_THROW(barycentric.evaluate(queries, ExtrapolationPolicy::THROW));
+
+            CubicSplineInterpolator<double> spline;
+            spline.fit(data, 1);
+            spline(0.25);
+
+            StatsSnapshot stats = Stats::snapshot();
+            // Nested fits (base class fit) are counted once
+            EXPECT_EQ(stats.fits, 2u);
+            EXPECT_EQ(stats.batches, 2u);
+            EXPECT_EQ(stats.batch_queries, 6u);
+            EXPECT_EQ(stats.queries, 7u);
+            EXPECT_EQ(stats.extrapolations, 2u);
+            EXPECT_EQ(stats.extrapolation_errors, 1u);
+            // 0.5 is a node, evaluated by both batches
+            EXPECT_EQ(stats.exact_node_hits, 2u);
+            EXPECT_EQ(stats.bin_searches, 1u);
+            EXPECT_FALSE(stats.to_string().empty());
+
+            Stats::reset();
+            EXPECT_EQ(Stats::snapshot().fits, 0u);
+        }
+
+        void Reader()
+        {
+            DataReader<double>::read("../test/data/valid_datafile.txt");
+            StatsSnapshot stats = Stats::snapshot();
+            EXPECT_EQ(stats.files_read, 1u);
+            EXPECT_EQ(stats.bytes_read, std::filesystem::file_size("../test/data/valid_datafile.txt"));
+        }
+};
+
+TEST_F(InstrumentationTest, Counters) { this->Counters(); }
+TEST_F(InstrumentationTest, Reader) { this->Reader(); }
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "data_reader.hpp"
+#include "datagen.hpp"
+#include "interpolation_pipeline.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Checks that the staged pipeline writes the same grids as a sequential fit & evaluation
+ *
+ */
+class InterpolationPipelineTest: public ::testing::Test {
+    protected:
+        std::filesystem::path dir;
+        Eigen::MatrixXd data;
+
+        void SetUp() override {
+            dir = std::filesystem::temp_directory_path() / "test_interpolation_pipeline";
+            std::filesystem::remove_all(dir);
+            std::filesystem::create_directories(dir);
+            data.resize(15, 2);
+            data.col(0) = Eigen::VectorXd::LinSpaced(15, -1.0, 1.0);
+            data.col(1) = (2.0 * data.col(0).array()).exp();
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(dir);
+        }
+
+        void Run()
+        {
+            std::vector<PipelineJob> jobs;
+            for (int j=0; j<3; j++)
+            {
+                Eigen::MatrixXd scaled = data;
+                scaled.col(1) *= j + 1.0;
+                const std::filesystem::path input = dir / std::format("data_{}.txt", j);
+                datagen<double>::write(input, scaled);
+                jobs.push_back({input, j == 0 ? dir / "copy.txt" : "", {dir / std::format("bary_{}.txt", j), dir / std::format("spline_{}.txt", j)}});
+            }
+
+            // Capacity 1, every stage waits on the next one
+            InterpolationPipeline<double> pipeline({"barycentric", "cubic_spline"}, {"natural"}, 101, 1);
+            PipelineTimings timings = pipeline.run(jobs);
+            EXPECT_GT(timings.wall, 0.0);
+            EXPECT_GT(timings.fit, 0.0);
+
+            EXPECT_TRUE(DataReader<double>::read(dir / "copy.txt") == data);
+            for (int j=0; j<3; j++)
+            {
+                BarycentricInterpolator<double> barycentric;
+                CubicSplineInterpolator<double> spline(CubicSplineInterpolator<double>::NATURAL);
+                barycentric.fit(data.col(0), data.col(1) * (j + 1.0));
+                spline.fit(data.col(0), data.col(1) * (j + 1.0));
+                Eigen::MatrixXd bary = DataReader<double>::read(jobs[j].outputs[0]);
+                Eigen::MatrixXd splines = DataReader<double>::read(jobs[j].outputs[1]);
+                ASSERT_EQ(bary.rows(), 101);
+                EXPECT_TRUE(bary.col(1).isApprox(barycentric(bary.leftCols(1))));
+                EXPECT_TRUE(splines.col(1).isApprox(spline(splines.leftCols(1))));
+            }
+        }
+
+        void Errors()
+        {
+            InterpolationPipeline<double> pipeline({"lagrange"}, {}, 10);
+            // Missing input: the error of the read stage stops the others
+            EXPECT_THROW(pipeline.run({{dir / "missing.txt", "", {dir / "out.txt"}}}), std::exception);
+            EXPECT_FALSE(std::filesystem::exists(dir / "out.txt"));
+            // One output per interpolator
+            EXPECT_THROW(pipeline.run({{dir / "missing.txt", "", {}}}), InterpolationProjectException);
+        }
+};
+
+TEST_F(InterpolationPipelineTest, Run) { this->Run(); }
+TEST_F(InterpolationPipelineTest, Errors) { this->Errors(); }
@@ -25,6 +25,7 @@ TEST_F(LagrangeInterpolatorTest, FitDataUsingY)  {this->FitDataUsingY();}
 TEST_F(LagrangeInterpolatorTest, FitRange)       {this->FitRange();}
 TEST_F(LagrangeInterpolatorTest, VectorDatapoints) {this->VectorDatapoints();}
 TEST_F(LagrangeInterpolatorTest, Extrapolation) {this->Extrapolation();}
+TEST_F(LagrangeInterpolatorTest, ExtrapolationPolicies) {this->ExtrapolationPolicies();}
 TEST_F(LagrangeInterpolatorTest, SingleDataPoint) {this->SingleDataPoint();}
 TEST_F(LagrangeInterpolatorTest, Multidimensional) {this->Multidimensional();}
 
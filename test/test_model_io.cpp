@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <fstream>
+#include "model_io.hpp"
+#include "project_exceptions.hpp"
+
+/**
+ * @brief Checks that the saved models evaluate bitwise identically once mapped back
+ *
+ */
+class ModelIOTest: public ::testing::Test {
+    protected:
+        std::filesystem::path path;
+        Eigen::VectorXd x, y;
+        Eigen::MatrixXd queries;
+
+        void SetUp() override {
+            path = std::filesystem::temp_directory_path() / "test_model_io.ipm";
+            x = Eigen::VectorXd::LinSpaced(20, -1.0, 1.0);
+            y = (3.0 * x.array()).sin();
+            queries = Eigen::VectorXd::LinSpaced(997, -1.0, 1.0);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(path);
+        }
+
+        void ExpectSameOutputs(PolynomialInterpolator<double>& fitted, MappedModel<double>& mapped)
+        {
+            EXPECT_TRUE(fitted(queries) == mapped(queries));
+            for (Eigen::Index i=0; i<queries.rows(); i+=97)
+            {
+                EXPECT_EQ(fitted(queries(i)), mapped(queries(i)));
+            }
+        }
+
+        void Lagrange()
+        {
+            LagrangeInterpolator<double> fitted;
+            fitted.fit(x, y);
+            ModelIO<double>::save(path, fitted);
+            std::unique_ptr<MappedModel<double>> mapped = ModelIO<double>::load(path);
+            EXPECT_EQ(mapped->kind(), ModelKind::LAGRANGE);
+            EXPECT_TRUE(mapped->nodes() == x);
+            this->ExpectSameOutputs(fitted, *mapped);
+        }
+
+        void Barycentric()
+        {
+            BarycentricInterpolator<double> fitted;
+            fitted.fit(x, y);
+            ModelIO<double>::save(path, fitted);
+            MappedBarycentricInterpolator<double> mapped(path);
+            EXPECT_TRUE(mapped.weights() == fitted.get_weights().col(0));
+            this->ExpectSameOutputs(fitted, mapped);
+        }
+
+        void CubicSpline()
+        {
+            CubicSplineInterpolator<double> fitted(CubicSplineInterpolator<double>::CLAMPED, Eigen::Vector2d(1.0, -2.0));
+            fitted.fit(x, y);
+            // Saved through the base class
+            ModelIO<double>::save(path, static_cast<const Interpolator<double>&>(fitted));
+            MappedCubicSplineInterpolator<double> mapped(path);
+            EXPECT_EQ(mapped.boundary_constraint(), CubicSplineInterpolator<double>::CLAMPED);
+            EXPECT_TRUE(mapped.clamped_values() == Eigen::Vector2d(1.0, -2.0));
+            EXPECT_TRUE(mapped.coefficients() == fitted.get_coefficients());
+            this->ExpectSameOutputs(fitted, mapped);
+        }
+
+        void ExtrapolationPolicyIsSaved()
+        {
+            BarycentricInterpolator<double> fitted;
+            fitted.fit(x, y);
+            fitted.set_extrapolation_policy(ExtrapolationPolicy::NAN_VALUE);
+            ModelIO<double>::save(path, fitted);
+            std::unique_ptr<MappedModel<double>> mapped = ModelIO<double>::load(path);
+            EXPECT_EQ(mapped->get_extrapolation_policy(), ExtrapolationPolicy::NAN_VALUE);
+            EXPECT_TRUE(std::isnan((*mapped)(2.0)));
+        }
+
+        void SummationModeIsSaved()
+        {
+            CubicSplineInterpolator<double> fitted;
+            fitted.fit(x, y);
+            fitted.set_summation_mode(SummationMode::COMPENSATED);
+            ModelIO<double>::save(path, fitted);
+            std::unique_ptr<MappedModel<double>> mapped = ModelIO<double>::load(path);
+            EXPECT_EQ(mapped->get_summation_mode(), SummationMode::COMPENSATED);
+            this->ExpectSameOutputs(fitted, *mapped);
+        }
+
+        template <typename Edit>
+        void WriteHeader(Edit edit)
+        {
+            ModelFileHeader header;
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            edit(header);
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        void ReadOnly()
+        {
+            LagrangeInterpolator<double> fitted;
+            fitted.fit(x, y);
+            ModelIO<double>::save(path, fitted);
+            std::unique_ptr<MappedModel<double>> mapped = ModelIO<double>::load(path);
+            EXPECT_ANY_THROW(mapped->fit(x, y));
+        }
+
+        void InvalidFiles()
+        {
+            BarycentricInterpolator<double> fitted;
+            fitted.fit(x, y);
+            ModelIO<double>::save(path, fitted);
+            // Wrong type & wrong scheme
+            EXPECT_THROW(ModelIO<float>::load(path), DataReaderException::InvalidType);
+            EXPECT_THROW(MappedLagrangeInterpolator<double> mapped(path), DataReaderException::InvalidType);
+            // Corrupted header fields
+            const ModelFileHeader header = ModelIO<double>::read_header(path);
+            this->WriteHeader([](ModelFileHeader& h) { h.n = (std::uint64_t(1) << 61) + 1; });
+            EXPECT_THROW(ModelIO<double>::load(path), DataReaderException);
+            this->WriteHeader([&](ModelFileHeader& h) { h = header; h.extrapolation_policy = 42; });
+            EXPECT_THROW(ModelIO<double>::load(path), DataReaderException);
+            this->WriteHeader([&](ModelFileHeader& h) { h = header; h.summation_mode = 42; });
+            EXPECT_THROW(ModelIO<double>::load(path), DataReaderException);
+            this->WriteHeader([&](ModelFileHeader& h) { h = header; });
+            // Truncated file
+            std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+            EXPECT_THROW(ModelIO<double>::load(path), DataReaderException);
+            // Not a model
+            std::ofstream(path) << "# 2 2\n1 2\n3 4\n";
+            EXPECT_THROW(ModelIO<double>::load(path), DataReaderException);
+        }
+};
+
+TEST_F(ModelIOTest, Lagrange) { this->Lagrange(); }
+TEST_F(ModelIOTest, Barycentric) { this->Barycentric(); }
+TEST_F(ModelIOTest, CubicSpline) { this->CubicSpline(); }
+TEST_F(ModelIOTest, ExtrapolationPolicyIsSaved) { this->ExtrapolationPolicyIsSaved(); }
+TEST_F(ModelIOTest, SummationModeIsSaved) { this->SummationModeIsSaved(); }
+TEST_F(ModelIOTest, ReadOnly) { this->ReadOnly(); }
+TEST_F(ModelIOTest, InvalidFiles) { this->InvalidFiles(); }
@@ -98,6 +98,39 @@ class PolynomialInterpolatorTest: public ::testing::Test {
             ASSERT_ANY_THROW((*interpolator)(query_points_extra)) << "Extrapolation should not be permitted!";
         }
 
+        void ExtrapolationPolicies()
+        {
+            // Mix of in range & out of range queries
+            Eigen::VectorXd queries(4);
+            queries << -2.0, -0.5, 0.5, 2.0;
+
+            // Default policy still throws
+            ASSERT_ANY_THROW(interpolator->evaluate(queries, ExtrapolationPolicy::THROW));
+
+            // Clamp evaluates at the range bounds
+            Eigen::VectorXd y = interpolator->evaluate(queries, ExtrapolationPolicy::CLAMP);
+            EXPECT_DOUBLE_EQ(y(0), (*interpolator)(-M_PI_2));
+            EXPECT_DOUBLE_EQ(y(3), (*interpolator)(M_PI_2));
+            EXPECT_DOUBLE_EQ(y(1), (*interpolator)(-0.5));
+
+            // NaN only for out of range values
+            y = interpolator->evaluate(queries, ExtrapolationPolicy::NAN_VALUE);
+            EXPECT_TRUE(std::isnan(y(0)));
+            EXPECT_TRUE(std::isnan(y(3)));
+            EXPECT_NEAR(y(2), std::cos(0.5), TEST_TOLERANCE);
+
+            // Extrapolation evaluates the model outside of the range
+            ASSERT_NO_THROW(y = interpolator->evaluate(queries, ExtrapolationPolicy::EXTRAPOLATE));
+            EXPECT_TRUE(std::isfinite(y(0)) && std::isfinite(y(3)));
+
+            // Interpolator wide policy applies to the scalar & batch operators
+            interpolator->set_extrapolation_policy(ExtrapolationPolicy::NAN_VALUE);
+            EXPECT_TRUE(std::isnan((*interpolator)(2.0)));
+            EXPECT_NO_THROW((*interpolator)(queries));
+            interpolator->set_extrapolation_policy(ExtrapolationPolicy::THROW);
+            EXPECT_ANY_THROW((*interpolator)(2.0));
+        }
+
         void Multidimensional() 
         {
             // Check for an excpetion if passing multidimensional datapoints
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <chrono>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include "barycentric_interpolator.hpp"
+#include "query_server.hpp"
+
+/**
+ * @brief Sends framed requests to a resident server through pipes & a Unix socket
+ *
+ */
+class QueryServerTest: public ::testing::Test {
+    protected:
+        std::shared_ptr<BarycentricInterpolator<double>> model;
+        Eigen::VectorXd queries;
+
+        void SetUp() override {
+            Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(10, 0.0, 1.0);
+            model = std::make_shared<BarycentricInterpolator<double>>();
+            model->fit(x, x.array().square().matrix());
+            queries = Eigen::VectorXd::LinSpaced(7, 0.0, 1.0);
+        }
+
+        static void WriteRequest(int fd, std::uint32_t id, QueryOp op, const std::string& name, const Eigen::VectorXd& values)
+        {
+            QueryRequestHeader header = {id, op, 0, static_cast<std::uint16_t>(name.size()), static_cast<std::uint64_t>(values.size())};
+            ASSERT_EQ(::write(fd, &header, sizeof(header)), sizeof(header));
+            ASSERT_EQ(::write(fd, name.data(), name.size()), name.size());
+            ASSERT_EQ(::write(fd, values.data(), values.size() * sizeof(double)), values.size() * sizeof(double));
+        }
+
+        static void ReadExact(int fd, void* data, std::size_t size)
+        {
+            char* bytes = static_cast<char*>(data);
+            while (size > 0)
+            {
+                ssize_t n = ::read(fd, bytes, size);
+                ASSERT_GT(n, 0);
+                bytes += n;
+                size -= n;
+            }
+        }
+
+        /* Reads one response, the payload is returned as values (OK evaluation) or as message */
+        static QueryResponseHeader ReadResponse(int fd, Eigen::VectorXd& values, std::string& message, bool text = false)
+        {
+            QueryResponseHeader header = {};
+            ReadExact(fd, &header, sizeof(header));
+            if (header.status == QueryStatus::OK && !text)
+            {
+                values.resize(header.count);
+                ReadExact(fd, values.data(), header.count * sizeof(double));
+            }
+            else
+            {
+                message.resize(header.count);
+                ReadExact(fd, message.data(), header.count);
+            }
+            return header;
+        }
+
+        void Pipes()
+        {
+            int requests[2], responses[2];
+            ASSERT_EQ(::pipe(requests), 0);
+            ASSERT_EQ(::pipe(responses), 0);
+            WriteRequest(requests[1], 1, QueryOp::EVALUATE, "square", queries);
+            WriteRequest(requests[1], 2, QueryOp::EVALUATE, "cube", queries);
+            WriteRequest(requests[1], 3, QueryOp::EVALUATE, "square", Eigen::VectorXd::Constant(1, 2.0));
+            ::close(requests[1]);
+
+            QueryServer<double> server(2);
+            server.add_model("square", model);
+            server.serve(requests[0], responses[1]);
+            ::close(requests[0]);
+            ::close(responses[1]);
+            EXPECT_EQ(server.latency().count(), 3);
+
+            // Responses may come in any order
+            bool seen[4] = {};
+            for (int i=0; i<3; i++)
+            {
+                Eigen::VectorXd values;
+                std::string message;
+                QueryResponseHeader header = ReadResponse(responses[0], values, message);
+                ASSERT_LE(header.id, 3);
+                seen[header.id] = true;
+                if (header.id == 1)
+                {
+                    ASSERT_EQ(header.status, QueryStatus::OK);
+                    EXPECT_TRUE(values == (*model)(queries));
+                }
+                else
+                {
+                    // Unknown model & extrapolation
+                    EXPECT_EQ(header.status, header.id == 2 ? QueryStatus::UNKNOWN_MODEL : QueryStatus::EVALUATION_ERROR);
+                    EXPECT_FALSE(message.empty());
+                }
+            }
+            EXPECT_TRUE(seen[1] && seen[2] && seen[3]);
+            ::close(responses[0]);
+        }
+
+        void PendingBytesBudget()
+        {
+            int requests[2], responses[2];
+            ASSERT_EQ(::pipe(requests), 0);
+            ASSERT_EQ(::pipe(responses), 0);
+            for (std::uint32_t id=0; id<8; id++) { WriteRequest(requests[1], id, QueryOp::EVALUATE, "square", queries); }
+            ::close(requests[1]);
+
+            // Too small for two requests, they are read & evaluated one at a time
+            QueryServer<double> server(4, 1);
+            server.add_model("square", model);
+            server.serve(requests[0], responses[1]);
+            ::close(requests[0]);
+            ::close(responses[1]);
+            EXPECT_EQ(server.latency().count(), 8);
+
+            for (int i=0; i<8; i++)
+            {
+                Eigen::VectorXd values;
+                std::string message;
+                QueryResponseHeader header = ReadResponse(responses[0], values, message);
+                EXPECT_EQ(header.id, i);
+                ASSERT_EQ(header.status, QueryStatus::OK);
+                EXPECT_TRUE(values == (*model)(queries));
+            }
+            ::close(responses[0]);
+        }
+
+        void Socket()
+        {
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_query_server.sock";
+            QueryServer<double> server(2);
+            server.add_model("square", model);
+            std::thread serving([&server, &path] { server.serve_socket(path); });
+
+            int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            // Wait for the server to listen
+            for (int attempt=0; attempt<500; attempt++)
+            {
+                if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) { break; }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            Eigen::VectorXd values;
+            std::string message;
+            WriteRequest(fd, 7, QueryOp::EVALUATE, "square", queries);
+            QueryResponseHeader header = ReadResponse(fd, values, message);
+            EXPECT_EQ(header.id, 7);
+            EXPECT_EQ(header.status, QueryStatus::OK);
+            EXPECT_TRUE(values == (*model)(queries));
+
+            WriteRequest(fd, 8, QueryOp::STATS, "", Eigen::VectorXd());
+            header = ReadResponse(fd, values, message, true);
+            EXPECT_EQ(header.status, QueryStatus::OK);
+            EXPECT_NE(message.find("requests: 1"), std::string::npos);
+
+            server.stop();
+            serving.join();
+            ::close(fd);
+            EXPECT_FALSE(std::filesystem::exists(path));
+        }
+};
+
+TEST_F(QueryServerTest, Pipes) { this->Pipes(); }
+TEST_F(QueryServerTest, PendingBytesBudget) { this->PendingBytesBudget(); }
+TEST_F(QueryServerTest, Socket) { this->Socket(); }
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include "data_reader.hpp"
+#include "datagen.hpp"
+#include "random_generator.hpp"
+
+/**
+ * @brief Checks the Philox generator & the reproducibility of the generated data
+ *
+ */
+class RandomGeneratorTest: public ::testing::Test {
+    protected:
+        void KnownAnswers()
+        {
+            // Random123 known answer tests for philox4x32-10
+            Philox4x32::Counter zero = Philox4x32::generate({0, 0, 0, 0}, {0, 0});
+            EXPECT_EQ(zero, (Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+            Philox4x32::Counter ones = Philox4x32::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+            EXPECT_EQ(ones, (Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+        }
+
+        void IndependentOfThreads()
+        {
+            RandomGenerator<double> generator(42);
+            // Large enough to be split between several threads
+            Eigen::MatrixXd serial(5 * MIN_RANDOM_ROWS_PER_THREAD, 3), parallel(5 * MIN_RANDOM_ROWS_PER_THREAD, 3);
+            generator.fill(serial, -1.0, 1.0, 0, 1);
+            generator.fill(parallel, -1.0, 1.0, 0, 7);
+            EXPECT_TRUE(serial == parallel);
+
+            // Chunks generated separately match the whole matrix
+            Eigen::MatrixXd chunk(300, 3);
+            generator.fill(chunk, -1.0, 1.0, 500, 2);
+            EXPECT_TRUE(chunk == serial.middleRows(500, 300));
+
+            RandomGenerator<double> other(43);
+            other.fill(parallel, -1.0, 1.0);
+            EXPECT_FALSE(serial == parallel);
+        }
+
+        void Range()
+        {
+            Eigen::VectorXf x(10000);
+            RandomGenerator<float>(7).fill(x, 2.0f, 3.0f, 0, 4);
+            EXPECT_GE(x.minCoeff(), 2.0f);
+            EXPECT_LT(x.maxCoeff(), 3.0f);
+            EXPECT_NEAR(x.mean(), 2.5f, 0.02f);
+
+            Eigen::VectorXi n(1000);
+            RandomGenerator<int>(7).fill(n, -3, 3);
+            EXPECT_EQ(n.minCoeff(), -3);
+            EXPECT_EQ(n.maxCoeff(), 3);
+
+            Eigen::VectorXd points(100);
+            datagen<double>::generate_points(points, {10.0, 20.0}, datagen<double>::PointGeneration::RANDOM_UNIFORM);
+            EXPECT_GE(points.minCoeff(), 10.0);
+            EXPECT_LT(points.maxCoeff(), 20.0);
+        }
+
+        void ReproducibleFile()
+        {
+            std::filesystem::path path = std::filesystem::temp_directory_path() / "test_random_generator.txt";
+            datagen<double>::random_data(path, DATAGEN_CHUNK_ROWS + 10, 2, 1);
+            Eigen::MatrixXd first = DataReader<double>::read(path);
+            datagen<double>::random_data(path, DATAGEN_CHUNK_ROWS + 10, 2, 1);
+            EXPECT_TRUE(DataReader<double>::read(path) == first);
+            std::filesystem::remove(path);
+        }
+};
+
+TEST_F(RandomGeneratorTest, KnownAnswers) { this->KnownAnswers(); }
+TEST_F(RandomGeneratorTest, IndependentOfThreads) { this->IndependentOfThreads(); }
+TEST_F(RandomGeneratorTest, Range) { this->Range(); }
+TEST_F(RandomGeneratorTest, ReproducibleFile) { this->ReproducibleFile(); }
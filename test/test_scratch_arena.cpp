@@ -0,0 +1,138 @@
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <atomic>
+#include <vector>
+#include "barycentric_interpolator.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "lagrange_interpolator.hpp"
+#include "scratch_arena.hpp"
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+/* Heap allocations of the test binary: Eigen allocates with malloc (as does operator new), so the
+ * glibc allocation functions are interposed rather than operator new */
+static std::atomic<std::size_t> allocations{0};
+
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) noexcept { allocations.fetch_add(1, std::memory_order_relaxed); return __libc_malloc(size); }
+void* calloc(std::size_t count, std::size_t size) noexcept { allocations.fetch_add(1, std::memory_order_relaxed); return __libc_calloc(count, size); }
+void* realloc(void* ptr, std::size_t size) noexcept { allocations.fetch_add(1, std::memory_order_relaxed); return __libc_realloc(ptr, size); }
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept { allocations.fetch_add(1, std::memory_order_relaxed); return __libc_memalign(alignment, size); }
+}
+#define COUNTED_ALLOCATIONS
+#endif
+
+/**
+ * @brief Checks the scratch arena & that refitting a model of the same size does not allocate
+ *
+ */
+class ScratchArenaTest: public ::testing::Test {
+    protected:
+        /* Number of heap allocations made by f */
+        template <typename F>
+        static std::size_t CountAllocations(F f)
+        {
+#ifdef COUNTED_ALLOCATIONS
+            const std::size_t before = allocations.load();
+            f();
+            return allocations.load() - before;
+#else
+            f();
+            return 0;
+#endif
+        }
+
+        void Reuse()
+        {
+            ScratchArena arena;
+            auto a = arena.vector<double>(100);
+            auto b = arena.matrix<float>(3, 7);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % SCRATCH_ARENA_ALIGNMENT, 0u);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % SCRATCH_ARENA_ALIGNMENT, 0u);
+            EXPECT_GE(reinterpret_cast<const char*>(b.data()), reinterpret_cast<const char*>(a.data() + 100));
+            EXPECT_EQ(arena.capacity(), std::size_t(SCRATCH_ARENA_MIN_BLOCK));
+
+            // Outgrowing the block chains new ones, merged into one by the reset
+            auto c = arena.vector<long double>(1000);
+            c.setZero();
+            EXPECT_GT(arena.capacity(), std::size_t(SCRATCH_ARENA_MIN_BLOCK));
+            const std::size_t capacity = arena.capacity();
+            arena.reset();
+            EXPECT_EQ(arena.capacity(), capacity);
+            const double* first = nullptr;
+            EXPECT_EQ(this->CountAllocations([&] {
+                for (int i=0; i<10; i++)
+                {
+                    arena.reset();
+                    first = arena.vector<double>(100).data();
+                    arena.matrix<float>(3, 7).setOnes();
+                    arena.vector<long double>(1000).setZero();
+                }
+            }), 0u);
+            arena.reset();
+            EXPECT_EQ(arena.vector<double>(1).data(), first);
+
+            // Copies start empty
+            ScratchArena copy(arena);
+            EXPECT_EQ(copy.capacity(), 0u);
+        }
+
+        void SteadyStateRefits()
+        {
+#ifndef COUNTED_ALLOCATIONS
+            GTEST_SKIP() << "allocation counting needs glibc without sanitizers";
+#endif
+            const int n = 200;
+            std::vector<Eigen::MatrixXd> datasets;
+            std::vector<Eigen::VectorXd> knots, values;
+            for (int k=0; k<8; k++)
+            {
+                Eigen::MatrixXd data(n, 2);
+                data.col(0) = Eigen::VectorXd::LinSpaced(n, -1.0, 1.0 + 0.1 * k);
+                data.col(1) = (data.col(0).array() * (k + 1)).sin();
+                datasets.push_back(data);
+                knots.push_back(data.col(0));
+                values.push_back(data.col(1));
+            }
+            const Eigen::MatrixXd X = datasets[0].col(0);
+
+            LagrangeInterpolator<double> lagrange;
+            BarycentricInterpolator<double> barycentric;
+            BarycentricInterpolator<double, float> barycentric_float;
+            CubicSplineInterpolator<double> spline;
+            CubicSplineInterpolator<double, float> spline_float;
+            CubicSplineInterpolator<double> clamped(CubicSplineInterpolator<double>::CLAMPED, Eigen::Vector2d(1.0, -1.0));
+            auto refit_all = [&] {
+                for (int k=0; k<8; k++)
+                {
+                    lagrange.fit(datasets[k], 1);
+                    barycentric.fit(datasets[k], 1);
+                    barycentric.fit(X, values[k]);
+                    barycentric_float.fit(datasets[k], 1);
+                    spline.fit(datasets[k], 1);
+                    spline.fit(knots[k], values[k]);
+                    spline_float.fit(datasets[k], 1);
+                    clamped.fit(datasets[k], 1);
+                }
+            };
+            // The first fits size the models & their scratch memory
+            EXPECT_GT(this->CountAllocations(refit_all), 0u);
+            EXPECT_EQ(this->CountAllocations(refit_all), 0u);
+
+            // The refitted models match fresh ones
+            CubicSplineInterpolator<double> fresh_spline;
+            BarycentricInterpolator<double> fresh_barycentric;
+            fresh_spline.fit(knots[7], values[7]);
+            fresh_barycentric.fit(X, values[7]);
+            EXPECT_TRUE(spline.get_coefficients() == fresh_spline.get_coefficients());
+            EXPECT_TRUE(barycentric.get_weights() == fresh_barycentric.get_weights());
+        }
+};
+
+TEST_F(ScratchArenaTest, Reuse) { this->Reuse(); }
+TEST_F(ScratchArenaTest, SteadyStateRefits) { this->SteadyStateRefits(); }
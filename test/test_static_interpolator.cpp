@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include "model_io.hpp"
+#include "static_interpolator.hpp"
+
+/**
+ * @brief Checks that the static dispatch evaluates like the virtual interface
+ *
+ */
+class StaticInterpolatorTest: public ::testing::Test {
+    protected:
+        Eigen::VectorXd x, y;
+        Eigen::MatrixXd queries;
+
+        void SetUp() override {
+            x = Eigen::VectorXd::LinSpaced(12, -1.0, 1.0);
+            y = (2.0 * x.array()).cos();
+            queries = Eigen::VectorXd::LinSpaced(301, -1.0, 1.0);
+        }
+
+        void ExpectSameOutputs(Interpolator<double>& interpolator, bool is_static)
+        {
+            const StaticInterpolator<double> dispatch(interpolator);
+            EXPECT_EQ(dispatch.is_static(), is_static);
+            const Eigen::VectorXd expected = interpolator(queries);
+            EXPECT_TRUE(dispatch(queries) == expected);
+            Eigen::VectorXd visited = dispatch.visit([&](auto& concrete) {
+                Eigen::VectorXd values(queries.rows());
+                for (Eigen::Index i=0; i<queries.rows(); i++) { values(i) = concrete(queries(i, 0)); }
+                return values;
+            });
+            EXPECT_TRUE(visited == expected);
+        }
+
+        void Dispatch()
+        {
+            LagrangeInterpolator<double> lagrange;
+            BarycentricInterpolator<double> barycentric;
+            CubicSplineInterpolator<double> spline;
+            lagrange.fit(x, y);
+            barycentric.fit(x, y);
+            spline.fit(x, y);
+            FourierApproximator<double> fourier;
+            fourier.fit(x, y);
+            this->ExpectSameOutputs(lagrange, true);
+            this->ExpectSameOutputs(barycentric, true);
+            this->ExpectSameOutputs(spline, true);
+            this->ExpectSameOutputs(fourier, true);
+
+            // The concrete type is resolved & the extrapolation policy still applies
+            const StaticInterpolator<double> dispatch(spline);
+            EXPECT_TRUE(dispatch.visit([](auto& concrete) { return std::is_same_v<std::decay_t<decltype(concrete)>, CubicSplineInterpolator<double>>; }));
+            EXPECT_THROW(dispatch(Eigen::MatrixXd::Constant(1, 1, 2.0)), InterpolationProjectException::Extrapolation);
+            spline.set_extrapolation_policy(ExtrapolationPolicy::NAN_VALUE);
+            EXPECT_TRUE(std::isnan(dispatch(Eigen::MatrixXd::Constant(1, 1, 2.0))(0)));
+        }
+
+        void Fallback()
+        {
+            // Unknown interpolators are evaluated through the virtual interface
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_static_interpolator.ipm";
+            BarycentricInterpolator<double> barycentric;
+            barycentric.fit(x, y);
+            ModelIO<double>::save(path, barycentric);
+            {
+                std::unique_ptr<MappedModel<double>> mapped = ModelIO<double>::load(path);
+                const StaticInterpolator<double> dispatch(*mapped);
+                EXPECT_FALSE(dispatch.is_static());
+                EXPECT_TRUE(dispatch(queries) == barycentric(queries));
+            }
+            std::filesystem::remove(path);
+        }
+};
+
+TEST_F(StaticInterpolatorTest, Dispatch) { this->Dispatch(); }
+TEST_F(StaticInterpolatorTest, Fallback) { this->Fallback(); }